@@ -0,0 +1,358 @@
+//! Runs a fixed shader corpus through every stage of the compile pipeline and
+//! reports per-stage latency percentiles, throughput and peak RSS as JSON.
+//!
+//!   zig build bench -- [--iterations N] [--output report.json]
+//!                      [--baseline baseline.json] [--tolerance 0.10]
+//!
+//! With `--baseline`, stages whose p50 regressed by more than the tolerance
+//! are reported and the process exits with status 1.
+
+const std = @import("std");
+const builtin = @import("builtin");
+const slang = @import("slang");
+
+const Shader = struct {
+    name: [:0]const u8,
+    source: [:0]const u8,
+};
+
+const corpus = [_]Shader{
+    .{ .name = "compute_blur", .source = @embedFile("shaders/compute_blur.slang") },
+    .{ .name = "pbr_material", .source = @embedFile("shaders/pbr_material.slang") },
+    .{ .name = "generic_lighting", .source = @embedFile("shaders/generic_lighting.slang") },
+};
+
+const Stage = enum {
+    create_session,
+    load_module,
+    link,
+    target_code,
+    reflection,
+};
+
+const stage_count = @typeInfo(Stage).@"enum".fields.len;
+
+const StageSamples = struct {
+    durations: std.ArrayList(u64) = .empty,
+    max_rss_growth_bytes: u64 = 0,
+};
+
+const StageReport = struct {
+    name: []const u8,
+    samples: usize,
+    p50_ns: u64,
+    p99_ns: u64,
+    mean_ns: u64,
+    throughput_per_sec: f64,
+    /// Largest resident-set growth across one run of the stage.
+    max_rss_growth_bytes: u64 = 0,
+};
+
+const Report = struct {
+    iterations: u32,
+    shader_count: usize,
+    /// Process-lifetime high-water mark, so it is reported once per run.
+    peak_rss_bytes: u64 = 0,
+    stages: []const StageReport,
+};
+
+const Options = struct {
+    iterations: u32 = 20,
+    output: ?[]const u8 = null,
+    baseline: ?[]const u8 = null,
+    tolerance: f64 = 0.10,
+};
+
+fn parseOptions(args: []const []const u8) !Options {
+    var options: Options = .{};
+    var i: usize = 1;
+    while (i < args.len) : (i += 1) {
+        const arg = args[i];
+        if (i + 1 >= args.len) {
+            std.log.err("missing value for {s}", .{arg});
+            return error.InvalidArgument;
+        }
+        const value = args[i + 1];
+        i += 1;
+        if (std.mem.eql(u8, arg, "--iterations")) {
+            options.iterations = try std.fmt.parseInt(u32, value, 10);
+        } else if (std.mem.eql(u8, arg, "--output")) {
+            options.output = value;
+        } else if (std.mem.eql(u8, arg, "--baseline")) {
+            options.baseline = value;
+        } else if (std.mem.eql(u8, arg, "--tolerance")) {
+            options.tolerance = try std.fmt.parseFloat(f64, value);
+        } else {
+            std.log.err("unknown option {s}", .{arg});
+            return error.InvalidArgument;
+        }
+    }
+    return options;
+}
+
+/// Current resident set size, or 0 where /proc is unavailable.
+fn currentRssBytes() u64 {
+    if (builtin.os.tag != .linux) return 0;
+    var buffer: [128]u8 = undefined;
+    const statm = std.fs.cwd().readFile("/proc/self/statm", &buffer) catch return 0;
+    var fields = std.mem.tokenizeScalar(u8, statm, ' ');
+    _ = fields.next();
+    const pages = std.fmt.parseInt(u64, fields.next() orelse return 0, 10) catch return 0;
+    return pages * std.heap.pageSize();
+}
+
+fn peakRssBytes() u64 {
+    if (builtin.os.tag == .windows) return 0;
+    const usage = std.posix.getrusage(std.posix.rusage.SELF);
+    const maxrss: u64 = @intCast(usage.maxrss);
+    // Linux reports KiB, macOS bytes.
+    return if (builtin.os.tag.isDarwin()) maxrss else maxrss * 1024;
+}
+
+fn logDiagnostics(diagnostics: slang.IBlob) void {
+    if (diagnostics == null) return;
+    var text: []const u8 = &.{};
+    if (slang.getBlobSlice(diagnostics, &text).isSuccess()) {
+        std.log.err("{s}", .{text});
+    }
+}
+
+/// Drops the previous stage's diagnostics before the out-parameter is reused.
+fn resetDiagnostics(diagnostics: *slang.IBlob) void {
+    _ = slang.release(diagnostics.*);
+    diagnostics.* = null;
+}
+
+fn visitTypeLayout(typeLayout: slang.TypeLayoutReflection, depth: u32) usize {
+    if (depth > 16 or typeLayout.ptr == null) return 0;
+    var count: usize = 1;
+    std.mem.doNotOptimizeAway(typeLayout.getSize(.UNIFORM));
+    switch (typeLayout.getKind()) {
+        .STRUCT => {
+            for (0..typeLayout.getFieldCount()) |i| {
+                count += visitVariableLayout(typeLayout.getFieldByIndex(@intCast(i)), depth + 1);
+            }
+        },
+        .ARRAY, .CONSTANT_BUFFER, .PARAMETER_BLOCK, .SHADER_STORAGE_BUFFER, .TEXTURE_BUFFER => {
+            count += visitTypeLayout(typeLayout.getElementType(), depth + 1);
+        },
+        else => {},
+    }
+    return count;
+}
+
+fn visitVariableLayout(variableLayout: slang.VariableLayoutReflection, depth: u32) usize {
+    if (variableLayout.ptr == null) return 0;
+    std.mem.doNotOptimizeAway(variableLayout.getBindingIndex());
+    std.mem.doNotOptimizeAway(variableLayout.getBindingSpace());
+    return 1 + visitTypeLayout(variableLayout.getType(), depth);
+}
+
+fn traverseReflection(layout: slang.ProgramLayout) usize {
+    const reflection: slang.Reflection = .{ .ptr = layout, .metadata = null };
+    var count: usize = 0;
+    for (0..reflection.getParameterCount()) |i| {
+        count += visitVariableLayout(reflection.getParameterByIndex(@intCast(i)), 0);
+    }
+    for (0..reflection.getEntryPointCount()) |i| {
+        const entryPoint = reflection.getEntryPointByIndex(@intCast(i));
+        std.mem.doNotOptimizeAway(entryPoint.getStage());
+        for (0..entryPoint.getParameterCount()) |j| {
+            count += visitVariableLayout(entryPoint.getParameterByIndex(@intCast(j)), 0);
+        }
+    }
+    return count;
+}
+
+/// Records the time since the last lap and the RSS growth since `rss` was
+/// sampled, then restarts the timer so the bookkeeping is not billed to the
+/// next stage.
+fn record(samples: *StageSamples, allocator: std.mem.Allocator, timer: *std.time.Timer, rss: *u64) !void {
+    const elapsed = timer.lap();
+    const now = currentRssBytes();
+    samples.max_rss_growth_bytes = @max(samples.max_rss_growth_bytes, now -| rss.*);
+    rss.* = now;
+    try samples.durations.append(allocator, elapsed);
+    timer.reset();
+}
+
+fn runShader(allocator: std.mem.Allocator, shader: Shader, sessionDesc: *const slang.c.SessionDesc, stages: *[stage_count]StageSamples) !void {
+    var rss = currentRssBytes();
+    var timer = try std.time.Timer.start();
+    var diagnostics: slang.IBlob = null;
+    defer _ = slang.release(diagnostics);
+
+    var ss: slang.ISession = null;
+    if (!slang.createSession(slang.gs, sessionDesc, &ss).isSuccess()) return error.FailedToCreateSession;
+    defer _ = slang.release(ss);
+    try record(&stages[@intFromEnum(Stage.create_session)], allocator, &timer, &rss);
+
+    var module: slang.IModule = null;
+    const path = try std.fmt.allocPrintSentinel(allocator, "{s}.slang", .{shader.name}, 0);
+    defer allocator.free(path);
+    _ = timer.lap();
+    if (!slang.loadNamedModuleFromSourceString(ss, shader.name, path, shader.source, &module, &diagnostics).isSuccess()) {
+        logDiagnostics(diagnostics);
+        return error.FailedToLoadModule;
+    }
+    try record(&stages[@intFromEnum(Stage.load_module)], allocator, &timer, &rss);
+
+    var components: std.ArrayList(slang.IComponentType) = .empty;
+    defer {
+        // Everything after the module is an entry point this function owns.
+        if (components.items.len > 1) {
+            for (components.items[1..]) |entryPoint| _ = slang.release(entryPoint);
+        }
+        components.deinit(allocator);
+    }
+    try components.append(allocator, module);
+    const entryPointCount = slang.IModule_getDefinedEntryPointCount(module);
+    for (0..@intCast(entryPointCount)) |i| {
+        var entryPoint: slang.IEntryPoint = null;
+        if (!slang.IModule_getDefinedEntryPoint(module, @intCast(i), &entryPoint).isSuccess()) return error.FailedToGetEntryPoint;
+        try components.append(allocator, entryPoint);
+    }
+
+    _ = timer.lap();
+    var composite: slang.IComponentType = null;
+    resetDiagnostics(&diagnostics);
+    if (!slang.createCompositeComponent(ss, components.items, &composite, &diagnostics).isSuccess()) {
+        logDiagnostics(diagnostics);
+        return error.FailedToCreateComposite;
+    }
+    defer _ = slang.release(composite);
+    var linked: slang.IComponentType = null;
+    resetDiagnostics(&diagnostics);
+    if (!slang.linkProgram(composite, &linked, &diagnostics).isSuccess()) {
+        logDiagnostics(diagnostics);
+        return error.FailedToLinkProgram;
+    }
+    defer _ = slang.release(linked);
+    try record(&stages[@intFromEnum(Stage.link)], allocator, &timer, &rss);
+
+    var code: slang.IBlob = null;
+    resetDiagnostics(&diagnostics);
+    if (!slang.getTargetCode(linked, &code, &diagnostics).isSuccess()) {
+        logDiagnostics(diagnostics);
+        return error.FailedToGetTargetCode;
+    }
+    defer _ = slang.release(code);
+    try record(&stages[@intFromEnum(Stage.target_code)], allocator, &timer, &rss);
+
+    var layout: slang.ProgramLayout = null;
+    resetDiagnostics(&diagnostics);
+    if (!slang.getLayout(linked, 0, &layout, &diagnostics).isSuccess()) {
+        logDiagnostics(diagnostics);
+        return error.FailedToGetLayout;
+    }
+    std.mem.doNotOptimizeAway(traverseReflection(layout));
+    try record(&stages[@intFromEnum(Stage.reflection)], allocator, &timer, &rss);
+}
+
+fn percentile(sorted: []const u64, p: u64) u64 {
+    if (sorted.len == 0) return 0;
+    // Nearest-rank percentile.
+    const rank = (sorted.len * p + 99) / 100;
+    return sorted[@max(rank, 1) - 1];
+}
+
+fn summarize(allocator: std.mem.Allocator, stage: Stage, samples: *StageSamples) !StageReport {
+    const sorted = try allocator.dupe(u64, samples.durations.items);
+    defer allocator.free(sorted);
+    std.mem.sort(u64, sorted, {}, std.sort.asc(u64));
+
+    var total: u64 = 0;
+    for (sorted) |d| total += d;
+    const mean = if (sorted.len == 0) 0 else total / sorted.len;
+    const seconds = @as(f64, @floatFromInt(total)) / std.time.ns_per_s;
+
+    return .{
+        .name = @tagName(stage),
+        .samples = sorted.len,
+        .p50_ns = percentile(sorted, 50),
+        .p99_ns = percentile(sorted, 99),
+        .mean_ns = mean,
+        .throughput_per_sec = if (seconds > 0) @as(f64, @floatFromInt(sorted.len)) / seconds else 0,
+        .max_rss_growth_bytes = samples.max_rss_growth_bytes,
+    };
+}
+
+fn compareWithBaseline(allocator: std.mem.Allocator, report: Report, path: []const u8, tolerance: f64) !bool {
+    const bytes = try std.fs.cwd().readFileAlloc(allocator, path, 16 * 1024 * 1024);
+    defer allocator.free(bytes);
+    const parsed = try std.json.parseFromSlice(Report, allocator, bytes, .{ .ignore_unknown_fields = true });
+    defer parsed.deinit();
+
+    var regressed = false;
+    for (report.stages) |current| {
+        for (parsed.value.stages) |previous| {
+            if (!std.mem.eql(u8, current.name, previous.name) or previous.p50_ns == 0) continue;
+            const ratio = @as(f64, @floatFromInt(current.p50_ns)) / @as(f64, @floatFromInt(previous.p50_ns));
+            if (ratio > 1.0 + tolerance) {
+                std.log.warn("{s}: p50 {d} ns vs baseline {d} ns ({d:.1}% slower)", .{ current.name, current.p50_ns, previous.p50_ns, (ratio - 1.0) * 100.0 });
+                regressed = true;
+            }
+        }
+    }
+    return regressed;
+}
+
+pub fn main() !void {
+    var gpa: std.heap.GeneralPurposeAllocator(.{}) = .init;
+    defer _ = gpa.deinit();
+    const allocator = gpa.allocator();
+
+    const args = try std.process.argsAlloc(allocator);
+    defer std.process.argsFree(allocator, args);
+    const options = try parseOptions(args);
+
+    slang.init();
+    defer slang.deinit();
+
+    const target = slang.TargetDesc.fromSpec(.{
+        .format = slang.CompileTarget.SPIRV,
+        .profile = slang.findProfile(slang.gs, "spirv_1_5"),
+    });
+    const sessionDesc = slang.SessionDesc.fromSpec(.{
+        .targets = &target,
+        .targetCount = 1,
+    });
+
+    var stages: [stage_count]StageSamples = @splat(.{});
+    defer for (&stages) |*samples| samples.durations.deinit(allocator);
+
+    for (0..options.iterations) |_| {
+        for (corpus) |shader| {
+            try runShader(allocator, shader, &sessionDesc, &stages);
+        }
+    }
+
+    var reports: [stage_count]StageReport = undefined;
+    for (&reports, &stages, 0..) |*out, *samples, i| {
+        out.* = try summarize(allocator, @enumFromInt(i), samples);
+    }
+    const report: Report = .{
+        .iterations = options.iterations,
+        .shader_count = corpus.len,
+        .peak_rss_bytes = peakRssBytes(),
+        .stages = &reports,
+    };
+
+    var writer = std.Io.Writer.Allocating.init(allocator);
+    defer writer.deinit();
+    try std.json.fmt(report, .{ .whitespace = .indent_2 }).format(&writer.writer);
+    try writer.writer.writeByte('\n');
+    const json = writer.written();
+
+    if (options.output) |path| {
+        try std.fs.cwd().writeFile(.{ .sub_path = path, .data = json });
+    } else {
+        try std.fs.File.stdout().writeAll(json);
+    }
+
+    if (options.baseline) |path| {
+        if (try compareWithBaseline(allocator, report, path, options.tolerance)) {
+            std.process.exit(1);
+        }
+    }
+}
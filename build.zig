@@ -48,9 +48,33 @@ pub fn build(b: *std.Build) void {
     lib.root_module.addLibraryPath(lib_path);
     lib.root_module.addLibraryPath(bin_path);
     lib.root_module.linkSystemLibrary("slang", .{});
-    lib.root_module.addCSourceFile(.{ .file = b.path("src/c/slangc.cpp"), .flags = &.{"-std=c++17"} });
+    lib.root_module.addCSourceFiles(.{
+        .root = b.path("src/c"),
+        .files = &.{
+            "slangc.cpp",
+            "slangc_cache.cpp",
+            "slangc_scheduler.cpp",
+            "slangc_pool.cpp",
+            "slangc_core_module.cpp",
+            "slangc_registry.cpp",
+            "slangc_binary_module.cpp",
+            "slangc_filesystem.cpp",
+            "slangc_timing.cpp",
+            "slangc_specialization.cpp",
+            "slangc_reflection_snapshot.cpp",
+        },
+        .flags = &.{"-std=c++17"},
+    });
 
     b.installArtifact(lib);
+
+    const lib_tests = b.addTest(.{
+        .root_module = lib.root_module,
+    });
+    const run_lib_tests = b.addRunArtifact(lib_tests);
+    run_lib_tests.step.dependOn(b.getInstallStep());
+    const test_step = b.step("test", "Run the library unit tests");
+    test_step.dependOn(&run_lib_tests.step);
     // Copy Slang shared libraries to the install directory
     const install_slang_lib = b.addInstallDirectory(.{
         .source_dir = lib_path,
@@ -88,4 +112,27 @@ pub fn build(b: *std.Build) void {
     const run_example = b.step("example", "Run the example executable");
     run_example_cmd.step.dependOn(b.getInstallStep());
     run_example.dependOn(&run_example_cmd.step);
+
+    const bench_mod = b.addModule("bench", .{
+        .root_source_file = b.path("bench/bench.zig"),
+        .target = target,
+        .optimize = optimize,
+    });
+    const bench = b.addExecutable(.{
+        .name = "bench",
+        .root_module = bench_mod,
+    });
+
+    bench_mod.addLibraryPath(lib_path);
+    bench_mod.addLibraryPath(bin_path);
+
+    bench_mod.addImport("slang", lib.root_module);
+
+    bench_mod.linkLibrary(lib);
+
+    const run_bench_cmd = b.addRunArtifact(bench);
+    if (b.args) |args| run_bench_cmd.addArgs(args);
+    const run_bench = b.step("bench", "Run the compile benchmark suite");
+    run_bench_cmd.step.dependOn(b.getInstallStep());
+    run_bench.dependOn(&run_bench_cmd.step);
 }
@@ -112,9 +112,9 @@ pub fn main() !void {
         assert(slang.getBlobSlice(diagnostics, &diag).isSuccess());
     }
 
-    var buf: [64 * 1024]u8 = undefined;
-    var fba = std.heap.FixedBufferAllocator.init(&buf);
-    const allocator = fba.allocator();
+    var builder: slang.ReflectionBuilder = .init(std.heap.page_allocator, .{});
+    defer builder.deinit();
+    const allocator = builder.begin();
 
     const reflection: slang.Reflection = .{ .ptr = layout, .metadata = entryPointMetadata };
 
@@ -17,7 +17,7 @@ pub fn findAttribute(self: *const @This(), comptime tag: std.meta.Tag(Annotation
 
 pub fn from(self: *const slang.FunctionReflection, allocator: Allocator) !Self {
     return .{
-        .name = try allocator.dupe(u8, self.getName()),
+        .name = try slang.names.internString(self.getName()),
         .parameters = try Self.getParameters(self, allocator),
         .annotation = try Self.toAnnotation(self, allocator),
     };
@@ -1,5 +1,4 @@
 const std = @import("std");
-const FixedBufferAllocator = std.heap.FixedBufferAllocator;
 const Allocator = std.mem.Allocator;
 const AutoHashMap = std.AutoHashMap;
 const ArrayList = std.ArrayList;
@@ -27,9 +26,16 @@ pub const Function = @import("function.zig");
 pub const Reflection = struct {
     const Self = @This();
 
+    // Descriptor slots captured up front; `bindingUsed` queries the metadata
+    // directly for anything outside them.
+    const usage_space_count = 4;
+    const usage_register_count = 64;
+
     allocator: Allocator,
     reflection: slang.Reflection,
     metadata: slang.IMetadata,
+    // Descriptor slots the entry point uses, captured once in `init`.
+    usage: slang.ParameterUsage,
 
     function: Function,
     stage: slang.Stage,
@@ -48,6 +54,7 @@ pub const Reflection = struct {
             .allocator = allocator,
             .reflection = reflection,
             .metadata = reflection.metadata,
+            .usage = try reflection.getParameterUsage(allocator, .DESCRIPTOR_TABLE_SLOT, usage_space_count, usage_register_count),
 
             .function = try Function.from(&reflection.getEntryPointByIndex(i).getFunction(), allocator),
             .stage = reflection.getEntryPointByIndex(i).getStage(),
@@ -119,7 +126,7 @@ pub const Reflection = struct {
 
                 // TODO: check if it's not the same buffer
                 const resource: Resource = .{
-                    .name = try self.allocator.dupe(u8, param.getVariable().getName()),
+                    .name = try slang.names.internString(param.getVariable().getName()),
                     .resourceType = resourceType,
                     .type = try Type.from(&param.getType(), self.allocator),
                     .userAttributes = try VariableWithAnnotation.getAnnotation(&param.getVariable(), self.allocator),
@@ -170,10 +177,15 @@ pub const Reflection = struct {
             },
         };
 
-        var used: bool = false;
-        if (!slang.IMetadata_isParameterLocationUsed(self.metadata, .DESCRIPTOR_TABLE_SLOT, stageId, @intCast(bindingCount.*), &used).isSuccess()) {
-            std.log.info("Failed to check parameter location usage", .{});
-        }
+        const used = if (self.usage.contains(stageId, bindingCount.*))
+            self.usage.isUsed(stageId, bindingCount.*)
+        else blk: {
+            var slotUsed = false;
+            if (!slang.IMetadata_isParameterLocationUsed(self.metadata, .DESCRIPTOR_TABLE_SLOT, stageId, bindingCount.*, &slotUsed).isSuccess()) {
+                std.log.err("Failed to check parameter location usage", .{});
+            }
+            break :blk slotUsed;
+        };
 
         std.log.info("Binding type: {any}, usage: {any} at index: {any} and slot: {any} used: {any}", .{
             resourceType, bindingType, bindingCount.*, stageId, used,
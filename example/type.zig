@@ -109,7 +109,7 @@ pub const Type = union(enum) {
                 .annotation = annotationsOf(self, allocator),
             } },
             .STRUCT => .{ .Structure = .{
-                .name = try allocator.dupe(u8, self.getName()),
+                .name = try slang.names.internString(self.getName()),
                 .fields = try Type.getFields(self, allocator),
                 .size = sizeOf(self),
                 .annotation = null,
@@ -123,7 +123,7 @@ pub const Type = union(enum) {
 
                 return .{
                     .Resource = .{
-                        .name = try allocator.dupe(u8, self.getName()),
+                        .name = try slang.names.internString(self.getName()),
                         .result = t,
                         .size = parentSize * size,
                         .access = self.getResourceAccess(),
@@ -136,14 +136,14 @@ pub const Type = union(enum) {
                 const t = try allocator.create(Type);
                 t.* = try from(&self.getElementType(), allocator);
                 return .{ .Array = .{
-                    .name = try allocator.dupe(u8, self.getName()),
+                    .name = try slang.names.internString(self.getName()),
                     .size = sizeOf(self),
                     .elementType = t,
                     .annotation = annotationsOf(self, allocator),
                 } };
             },
             .TEXTURE_BUFFER => .{ .Texture = .{
-                .name = try allocator.dupe(u8, self.getName()),
+                .name = try slang.names.internString(self.getName()),
                 .size = sizeOf(self),
                 .rowCount = self.getRowCount(),
                 .columnCount = self.getColumnCount(),
@@ -158,7 +158,7 @@ pub const Type = union(enum) {
                 const size = t.getSize() orelse 1;
 
                 return .{ .ConstantBuffer = .{
-                    .name = try allocator.dupe(u8, self.getName()),
+                    .name = try slang.names.internString(self.getName()),
                     .size = parentSize * size,
                     .type = t,
                     .annotation = annotationsOf(self, allocator),
@@ -172,7 +172,7 @@ pub const Type = union(enum) {
                 const size = t.getSize().?;
 
                 return .{ .Vector = .{
-                    .name = try allocator.dupe(u8, self.getName()),
+                    .name = try slang.names.internString(self.getName()),
                     .size = parentSize * size,
                     .type = t,
                     .annotation = annotationsOf(self, allocator),
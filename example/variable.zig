@@ -17,7 +17,7 @@ category: slang.ParameterCategory,
 
 pub fn fromLayout(self: *const slang.VariableLayoutReflection, allocator: Allocator) !Self {
     return .{
-        .name = try allocator.dupe(u8, self.getName()),
+        .name = try slang.names.internString(self.getName()),
         .bindingIndex = self.getBindingIndex(),
         .bindingSpace = self.getBindingSpace(),
         .offset = self.getOffset(self.getCategory()),
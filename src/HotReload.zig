@@ -0,0 +1,230 @@
+//! Watches the source files behind loaded modules with inotify and reports
+//! which modules and programs have to be rebuilt after an edit.
+//!
+//! Modules are tracked under a caller-chosen key together with the files
+//! Slang reports for them (`IModule_getDependencyFilePath`, which already
+//! covers everything they import). Programs and other derived objects are
+//! tracked with `addDependency`. A burst of saves is coalesced: `poll` only
+//! reports once no further change has arrived for the debounce interval, and
+//! then returns every key that transitively depends on a changed file. After
+//! rebuilding a module, call `trackModule` again so newly added imports are
+//! watched too.
+
+const std = @import("std");
+const builtin = @import("builtin");
+const lib = @import("lib.zig");
+
+const linux = std.os.linux;
+
+const Self = @This();
+
+pub const Error = error{
+    OutOfMemory,
+    UnsupportedPlatform,
+    Unsupported,
+} || std.posix.INotifyInitError || std.posix.INotifyAddWatchError || std.posix.PollError || std.posix.ReadError;
+
+const KeySet = std.StringArrayHashMapUnmanaged(void);
+
+const Node = struct {
+    // Files this node was built from.
+    files: std.ArrayList([]const u8) = .empty,
+    // Keys of nodes built from this one.
+    dependents: KeySet = .empty,
+};
+
+const watch_mask = linux.IN.CLOSE_WRITE | linux.IN.MOVED_TO | linux.IN.CREATE | linux.IN.DELETE;
+
+allocator: std.mem.Allocator,
+// Backs every interned string; they live as long as the service.
+arena: std.heap.ArenaAllocator,
+strings: std.StringHashMapUnmanaged(void) = .empty,
+fd: std.posix.fd_t,
+debounceNs: u64,
+nodes: std.StringHashMapUnmanaged(Node) = .empty,
+// Absolute file path -> keys of the modules built from it.
+fileDependents: std.StringHashMapUnmanaged(KeySet) = .empty,
+// Watch descriptor -> directory. Directories are watched rather than files so
+// editors that save by renaming a temporary file are still noticed.
+watches: std.AutoHashMapUnmanaged(i32, []const u8) = .empty,
+watchedDirs: std.StringHashMapUnmanaged(void) = .empty,
+// Files changed since the last report, and when the latest change arrived.
+changed: KeySet = .empty,
+lastChange: std.time.Instant = undefined,
+
+pub fn init(allocator: std.mem.Allocator, debounceMs: u32) Error!Self {
+    if (builtin.os.tag != .linux) return error.UnsupportedPlatform;
+    return .{
+        .allocator = allocator,
+        .arena = .init(allocator),
+        .fd = try std.posix.inotify_init1(linux.IN.NONBLOCK | linux.IN.CLOEXEC),
+        .debounceNs = @as(u64, debounceMs) * std.time.ns_per_ms,
+    };
+}
+
+pub fn deinit(self: *Self) void {
+    std.posix.close(self.fd);
+    var nodes = self.nodes.valueIterator();
+    while (nodes.next()) |node| {
+        node.files.deinit(self.allocator);
+        node.dependents.deinit(self.allocator);
+    }
+    self.nodes.deinit(self.allocator);
+    var dependents = self.fileDependents.valueIterator();
+    while (dependents.next()) |set| set.deinit(self.allocator);
+    self.fileDependents.deinit(self.allocator);
+    self.watches.deinit(self.allocator);
+    self.watchedDirs.deinit(self.allocator);
+    self.changed.deinit(self.allocator);
+    self.strings.deinit(self.allocator);
+    self.arena.deinit();
+    self.* = undefined;
+}
+
+/// Descriptor that polls readable when a watched directory changes, for
+/// callers that multiplex it with their own event loop.
+pub fn getFd(self: *const Self) std.posix.fd_t {
+    return self.fd;
+}
+
+fn intern(self: *Self, string: []const u8) error{OutOfMemory}![]const u8 {
+    const entry = try self.strings.getOrPut(self.allocator, string);
+    if (!entry.found_existing) {
+        entry.key_ptr.* = try self.arena.allocator().dupe(u8, string);
+    }
+    return entry.key_ptr.*;
+}
+
+fn getNode(self: *Self, key: []const u8) error{OutOfMemory}!*Node {
+    const entry = try self.nodes.getOrPut(self.allocator, key);
+    if (!entry.found_existing) entry.value_ptr.* = .{};
+    return entry.value_ptr;
+}
+
+fn watchDirectory(self: *Self, dir: []const u8) Error!void {
+    if (self.watchedDirs.contains(dir)) return;
+    const wd = try std.posix.inotify_add_watch(self.fd, dir, watch_mask);
+    try self.watchedDirs.put(self.allocator, dir, {});
+    try self.watches.put(self.allocator, wd, dir);
+}
+
+/// Records (or refreshes) the files `module` was built from under `key`.
+/// Files Slang did not read from disk, such as in-memory sources, are skipped.
+pub fn trackModule(self: *Self, key: []const u8, module: lib.IModule) Error!void {
+    const nodeKey = try self.intern(key);
+    const node = try self.getNode(nodeKey);
+    for (node.files.items) |file| {
+        if (self.fileDependents.getPtr(file)) |set| _ = set.swapRemove(nodeKey);
+    }
+    node.files.clearRetainingCapacity();
+
+    const count = lib.IModule_getDependencyFileCount(module);
+    for (0..@intCast(count)) |i| {
+        const path = lib.IModule_getDependencyFilePath(module, @intCast(i));
+        const absolute = std.fs.cwd().realpathAlloc(self.allocator, path) catch continue;
+        defer self.allocator.free(absolute);
+        const file = try self.intern(absolute);
+        try self.watchDirectory(try self.intern(std.fs.path.dirname(file) orelse "/"));
+
+        try node.files.append(self.allocator, file);
+        const set = try self.fileDependents.getOrPut(self.allocator, file);
+        if (!set.found_existing) set.value_ptr.* = .empty;
+        try set.value_ptr.put(self.allocator, nodeKey, {});
+    }
+}
+
+/// Marks `dependent` (for example a linked program) as built from
+/// `dependency` (a module key or another dependent).
+pub fn addDependency(self: *Self, dependent: []const u8, dependency: []const u8) error{OutOfMemory}!void {
+    const dependentKey = try self.intern(dependent);
+    _ = try self.getNode(dependentKey);
+    const node = try self.getNode(try self.intern(dependency));
+    try node.dependents.put(self.allocator, dependentKey, {});
+}
+
+/// Stops reporting `key`. Directories stay watched.
+pub fn untrack(self: *Self, key: []const u8) void {
+    const entry = self.nodes.fetchRemove(key) orelse return;
+    var node = entry.value;
+    for (node.files.items) |file| {
+        if (self.fileDependents.getPtr(file)) |set| _ = set.swapRemove(entry.key);
+    }
+    node.files.deinit(self.allocator);
+    node.dependents.deinit(self.allocator);
+    var nodes = self.nodes.valueIterator();
+    while (nodes.next()) |other| _ = other.dependents.swapRemove(entry.key);
+}
+
+fn drainEvents(self: *Self) Error!void {
+    var buffer: [4096]u8 align(@alignOf(linux.inotify_event)) = undefined;
+    var pathBuffer: [std.fs.max_path_bytes]u8 = undefined;
+    while (true) {
+        const size = std.posix.read(self.fd, &buffer) catch |err| switch (err) {
+            error.WouldBlock => return,
+            else => return err,
+        };
+        if (size == 0) return;
+        var offset: usize = 0;
+        while (offset < size) {
+            const event: *const linux.inotify_event = @ptrCast(@alignCast(&buffer[offset]));
+            offset += @sizeOf(linux.inotify_event) + event.len;
+            const name = event.getName() orelse continue;
+            const dir = self.watches.get(event.wd) orelse continue;
+            const path = std.fmt.bufPrint(&pathBuffer, "{s}/{s}", .{ dir, name }) catch continue;
+            // Only files some module was built from are interesting.
+            const file = self.fileDependents.getKey(path) orelse continue;
+            try self.changed.put(self.allocator, file, {});
+            self.lastChange = try std.time.Instant.now();
+        }
+    }
+}
+
+/// Appends every key that transitively depends on a changed file.
+fn collectAffected(self: *Self, affected: *std.ArrayList([]const u8)) error{OutOfMemory}!void {
+    var seen: KeySet = .empty;
+    defer seen.deinit(self.allocator);
+    for (self.changed.keys()) |file| {
+        const set = self.fileDependents.get(file) orelse continue;
+        for (set.keys()) |key| try seen.put(self.allocator, key, {});
+    }
+    // `seen` doubles as the work list; keys appended while walking are
+    // visited by the same loop.
+    var i: usize = 0;
+    while (i < seen.count()) : (i += 1) {
+        const node = self.nodes.get(seen.keys()[i]) orelse continue;
+        for (node.dependents.keys()) |key| try seen.put(self.allocator, key, {});
+    }
+    try affected.appendSlice(self.allocator, seen.keys());
+}
+
+/// Waits up to `timeoutMs` (-1 waits indefinitely) for changes to settle.
+/// Returns true after appending the affected keys to `affected`, which stay
+/// valid until `deinit`; returns false on timeout. Changes that have not
+/// settled by then are kept for the next call.
+pub fn poll(self: *Self, timeoutMs: i32, affected: *std.ArrayList([]const u8)) Error!bool {
+    const start = try std.time.Instant.now();
+    while (true) {
+        const now = try std.time.Instant.now();
+        var waitMs: i32 = -1;
+        if (self.changed.count() > 0) {
+            const quietNs = now.since(self.lastChange);
+            if (quietNs >= self.debounceNs) {
+                try self.collectAffected(affected);
+                self.changed.clearRetainingCapacity();
+                return true;
+            }
+            waitMs = @intCast(std.math.divCeil(u64, self.debounceNs - quietNs, std.time.ns_per_ms) catch unreachable);
+        }
+        if (timeoutMs >= 0) {
+            const elapsedMs = now.since(start) / std.time.ns_per_ms;
+            if (elapsedMs >= timeoutMs) return false;
+            const leftMs: i32 = @intCast(@as(u64, @intCast(timeoutMs)) - elapsedMs);
+            waitMs = if (waitMs < 0) leftMs else @min(waitMs, leftMs);
+        }
+
+        var fds = [_]std.posix.pollfd{.{ .fd = self.fd, .events = std.posix.POLL.IN, .revents = 0 }};
+        if (try std.posix.poll(&fds, waitMs) > 0) {
+            try self.drainEvents();
+        }
+    }
+}
@@ -0,0 +1,129 @@
+//! Links a module together with every entry point it defines once, then
+//! generates code per entry point and target only when it is first asked for.
+//! Generated blobs stay owned by the program until `deinit`.
+
+const std = @import("std");
+const lib = @import("lib.zig");
+
+const Self = @This();
+
+pub const Error = error{
+    OutOfMemory,
+    FailedToGetEntryPoint,
+    FailedToCreateComposite,
+    FailedToLinkProgram,
+    FailedToGetTargetCode,
+    InvalidArgument,
+};
+
+allocator: std.mem.Allocator,
+linked: lib.IComponentType,
+names: [][]const u8,
+targetCount: usize,
+// entryPointCount * targetCount, indexed by entryPointIndex * targetCount + targetIndex.
+codes: []lib.IBlob,
+
+/// `diagnostics` receives the link diagnostics, or those of the composition
+/// when linking reported nothing.
+pub fn init(allocator: std.mem.Allocator, ss: lib.ISession, module: lib.IModule, targetCount: usize, diagnostics: *lib.IBlob) Error!Self {
+    const entryPointCount: usize = @intCast(lib.IModule_getDefinedEntryPointCount(module));
+
+    const components = try allocator.alloc(lib.IComponentType, entryPointCount + 1);
+    defer allocator.free(components);
+    components[0] = module;
+
+    const names = try allocator.alloc([]const u8, entryPointCount);
+    errdefer allocator.free(names);
+
+    var loaded: usize = 0;
+    defer {
+        for (components[1 .. loaded + 1]) |entryPoint| {
+            _ = lib.release(entryPoint);
+        }
+    }
+    while (loaded < entryPointCount) : (loaded += 1) {
+        var entryPoint: lib.IEntryPoint = null;
+        if (!lib.IModule_getDefinedEntryPoint(module, @intCast(loaded), &entryPoint).isSuccess()) {
+            return error.FailedToGetEntryPoint;
+        }
+        components[loaded + 1] = entryPoint;
+        names[loaded] = lib.FunctionReflection_getName(lib.IEntryPoint_getFunctionReflection(entryPoint));
+    }
+
+    var composite: lib.IComponentType = null;
+    if (!lib.createCompositeComponent(ss, components, &composite, diagnostics).isSuccess()) {
+        return error.FailedToCreateComposite;
+    }
+    defer _ = lib.release(composite);
+
+    var linked: lib.IComponentType = null;
+    // Each call hands back its own blob, so the composition's is only kept
+    // when linking reported nothing.
+    var linkDiagnostics: lib.IBlob = null;
+    const linkResult = lib.linkProgram(composite, &linked, &linkDiagnostics);
+    if (linkDiagnostics != null) {
+        _ = lib.release(diagnostics.*);
+        diagnostics.* = linkDiagnostics;
+    }
+    if (!linkResult.isSuccess()) {
+        return error.FailedToLinkProgram;
+    }
+    errdefer _ = lib.release(linked);
+
+    const codes = try allocator.alloc(lib.IBlob, entryPointCount * targetCount);
+    @memset(codes, null);
+
+    return .{
+        .allocator = allocator,
+        .linked = linked,
+        .names = names,
+        .targetCount = targetCount,
+        .codes = codes,
+    };
+}
+
+pub fn deinit(self: *Self) void {
+    for (self.codes) |code| {
+        _ = lib.release(code);
+    }
+    self.allocator.free(self.codes);
+    self.allocator.free(self.names);
+    _ = lib.release(self.linked);
+}
+
+pub fn getEntryPointCount(self: *const Self) usize {
+    return self.names.len;
+}
+
+pub fn getEntryPointName(self: *const Self, entryPointIndex: usize) []const u8 {
+    return self.names[entryPointIndex];
+}
+
+pub fn findEntryPoint(self: *const Self, name: []const u8) ?usize {
+    for (self.names, 0..) |entryPointName, i| {
+        if (std.mem.eql(u8, entryPointName, name)) return i;
+    }
+    return null;
+}
+
+/// Returns the code for one entry point, generating it on the first call.
+pub fn getCode(self: *Self, entryPointIndex: usize, targetIndex: usize, diagnostics: *lib.IBlob) Error!lib.IBlob {
+    if (entryPointIndex >= self.names.len or targetIndex >= self.targetCount) {
+        return error.InvalidArgument;
+    }
+    const slot = &self.codes[entryPointIndex * self.targetCount + targetIndex];
+    if (slot.* == null) {
+        var code: lib.IBlob = null;
+        if (!lib.getEntryPointCode(self.linked, @intCast(entryPointIndex), @intCast(targetIndex), &code, diagnostics).isSuccess()) {
+            return error.FailedToGetTargetCode;
+        }
+        slot.* = code;
+    }
+    return slot.*;
+}
+
+/// Whether code for the entry point has already been generated.
+pub fn isGenerated(self: *const Self, entryPointIndex: usize, targetIndex: usize) bool {
+    if (entryPointIndex >= self.names.len or targetIndex >= self.targetCount) return false;
+    return self.codes[entryPointIndex * self.targetCount + targetIndex] != null;
+}
@@ -0,0 +1,224 @@
+//! Bitmap of the (space, register) locations an entry point uses for one
+//! parameter category, captured with a single `IMetadata_getParameterUsage`
+//! call. Set operations work a word at a time, so checking thousands of
+//! declared bindings against what the compiled code touches is a few loops
+//! over `u64`s instead of one FFI call per slot.
+
+const std = @import("std");
+const lib = @import("lib.zig");
+
+const Self = @This();
+
+pub const Location = struct {
+    space: u32,
+    register: u32,
+};
+
+allocator: std.mem.Allocator,
+spaceCount: u32,
+registerCount: u32,
+words: []u64,
+
+fn wordCount(spaceCount: u32, registerCount: u32) usize {
+    const bitCount = @as(u64, spaceCount) * registerCount;
+    return @intCast(std.math.divCeil(u64, bitCount, 64) catch unreachable);
+}
+
+/// An empty bitmap of the same shape as a capture, for building the set of
+/// declared locations to compare against.
+pub fn initEmpty(allocator: std.mem.Allocator, spaceCount: u32, registerCount: u32) error{OutOfMemory}!Self {
+    const words = try allocator.alloc(u64, wordCount(spaceCount, registerCount));
+    @memset(words, 0);
+    return .{
+        .allocator = allocator,
+        .spaceCount = spaceCount,
+        .registerCount = registerCount,
+        .words = words,
+    };
+}
+
+/// Captures which `category` locations below `spaceCount` and
+/// `registerCount` the entry point behind `metadata` uses.
+pub fn capture(
+    allocator: std.mem.Allocator,
+    metadata: lib.IMetadata,
+    category: lib.ParameterCategory,
+    spaceCount: u32,
+    registerCount: u32,
+) error{ OutOfMemory, FailedToQueryUsage }!Self {
+    var self = try initEmpty(allocator, spaceCount, registerCount);
+    errdefer self.deinit();
+    const result = lib.IMetadata_getParameterUsage(metadata, category, spaceCount, registerCount, self.words);
+    if (!result.isSuccess()) return error.FailedToQueryUsage;
+    return self;
+}
+
+pub fn deinit(self: *Self) void {
+    self.allocator.free(self.words);
+    self.* = undefined;
+}
+
+fn bitIndex(self: *const Self, space: u32, register: u32) ?u64 {
+    if (space >= self.spaceCount or register >= self.registerCount) return null;
+    return @as(u64, space) * self.registerCount + register;
+}
+
+/// Whether (`space`, `register`) lies inside the captured range.
+pub fn contains(self: *const Self, space: u32, register: u32) bool {
+    return self.bitIndex(space, register) != null;
+}
+
+/// Locations outside the captured range report unused; check `contains` and
+/// fall back to `IMetadata_isParameterLocationUsed` for those.
+pub fn isUsed(self: *const Self, space: u32, register: u32) bool {
+    const bit = self.bitIndex(space, register) orelse return false;
+    return self.words[@intCast(bit / 64)] & (@as(u64, 1) << @intCast(bit % 64)) != 0;
+}
+
+pub fn set(self: *Self, space: u32, register: u32) void {
+    const bit = self.bitIndex(space, register).?;
+    self.words[@intCast(bit / 64)] |= @as(u64, 1) << @intCast(bit % 64);
+}
+
+pub fn count(self: *const Self) usize {
+    var total: usize = 0;
+    for (self.words) |word| total += @popCount(word);
+    return total;
+}
+
+fn assertSameShape(self: *const Self, other: *const Self) void {
+    std.debug.assert(self.spaceCount == other.spaceCount and self.registerCount == other.registerCount);
+}
+
+/// Adds every location of `other`, e.g. to merge the usage of all entry
+/// points sharing a layout. Both bitmaps must have the same shape.
+pub fn setUnion(self: *Self, other: *const Self) void {
+    self.assertSameShape(other);
+    for (self.words, other.words) |*word, otherWord| word.* |= otherWord;
+}
+
+pub fn setIntersection(self: *Self, other: *const Self) void {
+    self.assertSameShape(other);
+    for (self.words, other.words) |*word, otherWord| word.* &= otherWord;
+}
+
+/// Removes every location of `other`. Subtracting the used locations from
+/// the declared ones leaves the dead bindings.
+pub fn setDifference(self: *Self, other: *const Self) void {
+    self.assertSameShape(other);
+    for (self.words, other.words) |*word, otherWord| word.* &= ~otherWord;
+}
+
+pub fn eql(self: *const Self, other: *const Self) bool {
+    return self.spaceCount == other.spaceCount and
+        self.registerCount == other.registerCount and
+        std.mem.eql(u64, self.words, other.words);
+}
+
+pub const Iterator = struct {
+    usage: *const Self,
+    wordIndex: usize = 0,
+    word: u64 = 0,
+
+    pub fn next(self: *Iterator) ?Location {
+        while (self.word == 0) {
+            if (self.wordIndex >= self.usage.words.len) return null;
+            self.word = self.usage.words[self.wordIndex];
+            self.wordIndex += 1;
+        }
+        const bit = @as(u64, self.wordIndex - 1) * 64 + @ctz(self.word);
+        self.word &= self.word - 1;
+        return .{
+            .space = @intCast(bit / self.usage.registerCount),
+            .register = @intCast(bit % self.usage.registerCount),
+        };
+    }
+};
+
+/// Visits the set locations in (space, register) order.
+pub fn iterator(self: *const Self) Iterator {
+    return .{ .usage = self };
+}
+
+const testing = std.testing;
+
+test "ParameterUsage: contains and isUsed at the edges of the range" {
+    var usage = try initEmpty(testing.allocator, 3, 40);
+    defer usage.deinit();
+    try testing.expectEqual(@as(usize, 2), usage.words.len);
+
+    try testing.expect(usage.contains(0, 0));
+    try testing.expect(usage.contains(2, 39));
+    try testing.expect(!usage.contains(2, 40));
+    try testing.expect(!usage.contains(3, 0));
+    try testing.expect(!usage.contains(std.math.maxInt(u32), std.math.maxInt(u32)));
+
+    usage.set(0, 0);
+    usage.set(2, 39);
+    try testing.expect(usage.isUsed(0, 0));
+    try testing.expect(usage.isUsed(2, 39));
+    try testing.expect(!usage.isUsed(0, 1));
+    try testing.expect(!usage.isUsed(2, 38));
+    try testing.expect(!usage.isUsed(2, 40));
+    try testing.expect(!usage.isUsed(3, 0));
+    try testing.expectEqual(@as(usize, 2), usage.count());
+}
+
+test "ParameterUsage: an empty shape contains nothing" {
+    var usage = try initEmpty(testing.allocator, 0, 16);
+    defer usage.deinit();
+    try testing.expectEqual(@as(usize, 0), usage.words.len);
+    try testing.expect(!usage.contains(0, 0));
+    try testing.expect(!usage.isUsed(0, 0));
+    var it = usage.iterator();
+    try testing.expectEqual(@as(?Location, null), it.next());
+}
+
+test "ParameterUsage: iterator visits locations across word boundaries in order" {
+    var usage = try initEmpty(testing.allocator, 3, 40);
+    defer usage.deinit();
+    // Bits 63 and 64 straddle the first word boundary.
+    const expected = [_]Location{
+        .{ .space = 0, .register = 5 },
+        .{ .space = 1, .register = 23 },
+        .{ .space = 1, .register = 24 },
+        .{ .space = 2, .register = 39 },
+    };
+    var i = expected.len;
+    while (i > 0) {
+        i -= 1;
+        usage.set(expected[i].space, expected[i].register);
+    }
+
+    var it = usage.iterator();
+    for (expected) |location| try testing.expectEqual(@as(?Location, location), it.next());
+    try testing.expectEqual(@as(?Location, null), it.next());
+}
+
+test "ParameterUsage: set operations" {
+    var declared = try initEmpty(testing.allocator, 2, 40);
+    defer declared.deinit();
+    var used = try initEmpty(testing.allocator, 2, 40);
+    defer used.deinit();
+    declared.set(0, 1);
+    declared.set(1, 30);
+    declared.set(1, 39);
+    used.set(1, 30);
+    used.set(0, 2);
+
+    var dead = try initEmpty(testing.allocator, 2, 40);
+    defer dead.deinit();
+    dead.setUnion(&declared);
+    try testing.expect(dead.eql(&declared));
+    dead.setDifference(&used);
+    try testing.expectEqual(@as(usize, 2), dead.count());
+    try testing.expect(dead.isUsed(0, 1) and dead.isUsed(1, 39) and !dead.isUsed(1, 30));
+
+    declared.setIntersection(&used);
+    try testing.expectEqual(@as(usize, 1), declared.count());
+    try testing.expect(declared.isUsed(1, 30));
+
+    used.setUnion(&dead);
+    try testing.expectEqual(@as(usize, 4), used.count());
+    try testing.expect(!used.eql(&dead));
+}
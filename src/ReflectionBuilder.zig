@@ -0,0 +1,66 @@
+//! Arena for converting reflection into caller-side structures. Every node,
+//! array and string of one conversion comes out of a single arena, and
+//! `begin` rewinds it for the next compile while keeping the memory it grew
+//! to. After the first large program, later conversions usually run out of
+//! one retained buffer, and freeing a whole tree costs a single reset.
+//!
+//! ```zig
+//! var builder: slang.ReflectionBuilder = .init(std.heap.page_allocator, .{});
+//! defer builder.deinit();
+//! for (programs) |program| {
+//!     const entry = try Reflection.init(program, 0, builder.begin());
+//!     // `entry` is valid until the next `begin`.
+//! }
+//! ```
+
+const std = @import("std");
+
+const Self = @This();
+
+pub const Options = struct {
+    /// Bytes reserved up front, e.g. the `getCapacity` of an earlier run.
+    initialCapacity: usize = 0,
+    /// Upper bound on what `begin` keeps between conversions, so one unusually
+    /// large program does not pin its memory forever. Null keeps everything.
+    retainLimit: ?usize = null,
+};
+
+arena: std.heap.ArenaAllocator,
+retainLimit: ?usize,
+
+pub fn init(child: std.mem.Allocator, options: Options) Self {
+    var self: Self = .{
+        .arena = .init(child),
+        .retainLimit = options.retainLimit,
+    };
+    if (options.initialCapacity > 0) {
+        // Allocating and rewinding leaves one buffer of that size behind. A
+        // failure here only means the first conversion grows it instead.
+        if (self.arena.allocator().alloc(u8, options.initialCapacity)) |_| {
+            _ = self.arena.reset(.retain_capacity);
+        } else |_| {}
+    }
+    return self;
+}
+
+pub fn deinit(self: *Self) void {
+    self.arena.deinit();
+    self.* = undefined;
+}
+
+/// Invalidates everything built since the previous `begin` and returns the
+/// allocator for the next conversion.
+pub fn begin(self: *Self) std.mem.Allocator {
+    _ = self.arena.reset(if (self.retainLimit) |limit| .{ .retain_with_limit = limit } else .retain_capacity);
+    return self.arena.allocator();
+}
+
+/// Allocator for the current conversion, without rewinding.
+pub fn allocator(self: *Self) std.mem.Allocator {
+    return self.arena.allocator();
+}
+
+/// Bytes currently held by the arena, used or not.
+pub fn getCapacity(self: *const Self) usize {
+    return self.arena.queryCapacity();
+}
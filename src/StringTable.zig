@@ -0,0 +1,165 @@
+//! Thread-safe interned string table. Each distinct string is copied once and
+//! gets a dense `Id`; the interned bytes never move, so the returned slices
+//! stay valid until `deinit` and two interned names are equal exactly when
+//! their ids are. Reflection names repeat heavily across shaders (field,
+//! type and resource names), so interning them keeps one copy per name.
+
+const std = @import("std");
+
+const Self = @This();
+
+pub const Id = enum(u32) { _ };
+
+allocator: std.mem.Allocator,
+mutex: std.Thread.Mutex = .{},
+// Backs the interned bytes.
+arena: std.heap.ArenaAllocator,
+ids: std.StringHashMapUnmanaged(Id) = .empty,
+strings: std.ArrayList([:0]const u8) = .empty,
+
+pub fn init(allocator: std.mem.Allocator) Self {
+    return .{
+        .allocator = allocator,
+        .arena = .init(allocator),
+    };
+}
+
+pub fn deinit(self: *Self) void {
+    self.ids.deinit(self.allocator);
+    self.strings.deinit(self.allocator);
+    self.arena.deinit();
+    self.* = undefined;
+}
+
+/// Forgets every interned string and frees their bytes. Ids and slices
+/// handed out earlier become invalid.
+pub fn reset(self: *Self) void {
+    self.mutex.lock();
+    defer self.mutex.unlock();
+    self.ids.clearRetainingCapacity();
+    self.strings.clearRetainingCapacity();
+    _ = self.arena.reset(.free_all);
+}
+
+fn internLocked(self: *Self, string: []const u8) error{OutOfMemory}!Id {
+    if (self.ids.get(string)) |id| return id;
+    try self.ids.ensureUnusedCapacity(self.allocator, 1);
+    try self.strings.ensureUnusedCapacity(self.allocator, 1);
+    const copy = try self.arena.allocator().dupeZ(u8, string);
+    const id: Id = @enumFromInt(self.strings.items.len);
+    self.strings.appendAssumeCapacity(copy);
+    self.ids.putAssumeCapacityNoClobber(copy, id);
+    return id;
+}
+
+/// Returns the id of `string`, copying it on first sight.
+pub fn intern(self: *Self, string: []const u8) error{OutOfMemory}!Id {
+    self.mutex.lock();
+    defer self.mutex.unlock();
+    return self.internLocked(string);
+}
+
+/// Like `intern` but returns the interned copy, for code that stores names
+/// as slices.
+pub fn internString(self: *Self, string: []const u8) error{OutOfMemory}![:0]const u8 {
+    self.mutex.lock();
+    defer self.mutex.unlock();
+    return self.strings.items[@intFromEnum(try self.internLocked(string))];
+}
+
+/// Id of `string` if it has been interned, without inserting it. Lets callers
+/// turn a name they search for into an id once and compare ids afterwards.
+pub fn find(self: *Self, string: []const u8) ?Id {
+    self.mutex.lock();
+    defer self.mutex.unlock();
+    return self.ids.get(string);
+}
+
+pub fn get(self: *Self, id: Id) [:0]const u8 {
+    self.mutex.lock();
+    defer self.mutex.unlock();
+    return self.strings.items[@intFromEnum(id)];
+}
+
+pub fn count(self: *Self) usize {
+    self.mutex.lock();
+    defer self.mutex.unlock();
+    return self.strings.items.len;
+}
+
+const testing = std.testing;
+
+test "StringTable: equal strings share one id and one copy" {
+    var table: Self = .init(testing.allocator);
+    defer table.deinit();
+
+    var buffer = "position".*;
+    const a = try table.intern("position");
+    const b = try table.intern(&buffer);
+    const other = try table.intern("normal");
+    try testing.expectEqual(a, b);
+    try testing.expect(a != other);
+    try testing.expectEqual(@as(usize, 2), table.count());
+
+    const copy = try table.internString(&buffer);
+    try testing.expectEqual(table.get(a).ptr, copy.ptr);
+    try testing.expect(@intFromPtr(copy.ptr) != @intFromPtr(&buffer));
+    try testing.expectEqualStrings("position", copy);
+    try testing.expectEqual(@as(u8, 0), copy[copy.len]);
+}
+
+test "StringTable: interned slices stay put as the table grows" {
+    var table: Self = .init(testing.allocator);
+    defer table.deinit();
+
+    const first = try table.internString("first");
+    var buffer: [16]u8 = undefined;
+    for (0..1000) |i| {
+        _ = try table.intern(try std.fmt.bufPrint(&buffer, "name{d}", .{i}));
+    }
+    try testing.expectEqual(@as(usize, 1001), table.count());
+    try testing.expectEqual(first.ptr, (try table.internString("first")).ptr);
+    try testing.expectEqualStrings("name999", table.get(table.find("name999").?));
+}
+
+test "StringTable: find does not insert" {
+    var table: Self = .init(testing.allocator);
+    defer table.deinit();
+
+    try testing.expectEqual(@as(?Id, null), table.find("color"));
+    try testing.expectEqual(@as(usize, 0), table.count());
+    const id = try table.intern("color");
+    try testing.expectEqual(@as(?Id, id), table.find("color"));
+}
+
+test "StringTable: reset forgets every string" {
+    var table: Self = .init(testing.allocator);
+    defer table.deinit();
+
+    _ = try table.intern("a");
+    _ = try table.intern("b");
+    table.reset();
+    try testing.expectEqual(@as(usize, 0), table.count());
+    try testing.expectEqual(@as(?Id, null), table.find("a"));
+    try testing.expectEqualStrings("b", table.get(try table.intern("b")));
+}
+
+test "StringTable: concurrent interning agrees on ids" {
+    var table: Self = .init(testing.allocator);
+    defer table.deinit();
+
+    const names = [_][]const u8{ "albedo", "normal", "roughness", "metallic", "emissive", "occlusion" };
+    var results: [4][names.len]Id = undefined;
+    const worker = struct {
+        fn run(t: *Self, out: *[names.len]Id) !void {
+            for (names, out) |name, *id| id.* = try t.intern(name);
+        }
+    }.run;
+    var threads: [results.len]std.Thread = undefined;
+    for (&threads, &results) |*thread, *out| thread.* = try std.Thread.spawn(.{}, worker, .{ &table, out });
+    for (threads) |thread| thread.join();
+
+    try testing.expectEqual(@as(usize, names.len), table.count());
+    for (results[1..]) |out| try testing.expectEqualSlices(Id, &results[0], &out);
+    for (names, results[0]) |name, id| try testing.expectEqualStrings(name, table.get(id));
+}
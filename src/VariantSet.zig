@@ -0,0 +1,296 @@
+//! Compiles one entry point under many `#define` permutations on a
+//! `CompileScheduler` and keeps one blob per distinct output. Permutations
+//! that produce byte-identical code share a blob, so `getCode` maps every
+//! permutation to its unique code without storing duplicates.
+//!
+//! Macros are prepended to the source as `#define` lines, so they only reach
+//! that source. Modules it `import`s are preprocessed on their own and never
+//! see them; a permutation whose branch lives in an imported module compiles
+//! the same code as every other permutation.
+
+const std = @import("std");
+const lib = @import("lib.zig");
+
+const Self = @This();
+
+pub const Error = error{
+    OutOfMemory,
+    FailedToSubmit,
+    FailedToCreateScheduler,
+    InvalidArgument,
+};
+
+/// A macro defined at the top of the entry point's source. It is not visible
+/// to imported modules.
+pub const Define = struct {
+    name: []const u8,
+    value: []const u8 = "1",
+};
+
+/// One axis of a permutation matrix: a macro and the values it can take.
+pub const Axis = struct {
+    name: []const u8,
+    values: []const []const u8,
+};
+
+const Digest = [std.crypto.hash.sha2.Sha256.digest_length]u8;
+
+allocator: std.mem.Allocator,
+// Distinct target code, owned by the set.
+blobs: std.ArrayList(lib.IBlob),
+// Per permutation: index into `blobs`, or null if the permutation failed.
+indices: []?u32,
+// Per permutation compile result and diagnostics (may be null).
+results: []lib.SlangResult,
+diagnostics: []lib.IBlob,
+
+/// Expands `axes` into their cartesian product, first axis varying slowest.
+/// Free with `freePermutations`.
+pub fn expandAxes(allocator: std.mem.Allocator, axes: []const Axis) Error![][]Define {
+    var count: usize = 1;
+    for (axes) |axis| {
+        if (axis.values.len == 0) return error.InvalidArgument;
+        count = std.math.mul(usize, count, axis.values.len) catch return error.OutOfMemory;
+    }
+
+    const permutations = try allocator.alloc([]Define, count);
+    var built: usize = 0;
+    errdefer {
+        for (permutations[0..built]) |defines| allocator.free(defines);
+        allocator.free(permutations);
+    }
+    while (built < count) : (built += 1) {
+        const defines = try allocator.alloc(Define, axes.len);
+        var rest = built;
+        var i = axes.len;
+        while (i > 0) {
+            i -= 1;
+            const values = axes[i].values;
+            defines[i] = .{ .name = axes[i].name, .value = values[rest % values.len] };
+            rest /= values.len;
+        }
+        permutations[built] = defines;
+    }
+    return permutations;
+}
+
+pub fn freePermutations(allocator: std.mem.Allocator, permutations: [][]Define) void {
+    for (permutations) |defines| allocator.free(defines);
+    allocator.free(permutations);
+}
+
+/// Prepends one `#define` line per macro, then resets the line counter so
+/// diagnostics point at lines in the original `source`.
+fn buildSource(allocator: std.mem.Allocator, source: []const u8, defines: []const Define) Error![:0]u8 {
+    var out: std.Io.Writer.Allocating = .init(allocator);
+    defer out.deinit();
+    for (defines) |define| {
+        if (define.name.len == 0 or
+            std.mem.indexOfAny(u8, define.name, " \t\r\n(") != null or
+            std.mem.indexOfAny(u8, define.value, "\r\n") != null)
+        {
+            return error.InvalidArgument;
+        }
+        out.writer.print("#define {s} {s}\n", .{ define.name, define.value }) catch return error.OutOfMemory;
+    }
+    out.writer.print("#line 1\n{s}", .{source}) catch return error.OutOfMemory;
+    return out.toOwnedSliceSentinel(0) catch return error.OutOfMemory;
+}
+
+/// Submits one job per permutation to `scheduler`, waits for all of them and
+/// deduplicates the resulting code. Individual permutations may fail; check
+/// `results` or `getCode` returning null. Workers reuse their sessions across
+/// permutations, so the core module and any imports load once per thread.
+/// Every permutation also leaves its module in a worker session until the
+/// worker retires it (see `maxJobsPerSession`) or the scheduler is destroyed;
+/// `compileWithOwnScheduler` frees them before returning.
+pub fn compile(
+    allocator: std.mem.Allocator,
+    scheduler: lib.CompileScheduler,
+    source: []const u8,
+    entryPointName: [:0]const u8,
+    stage: lib.Stage,
+    permutations: []const []const Define,
+) Error!Self {
+    const jobs = try allocator.alloc(lib.CompileJob, permutations.len);
+    defer allocator.free(jobs);
+    const compileResults = try allocator.alloc(lib.CompileResult, permutations.len);
+    defer allocator.free(compileResults);
+
+    var submitted: usize = 0;
+    var submitError: ?Error = null;
+    while (submitted < permutations.len) : (submitted += 1) {
+        const permutationSource = buildSource(allocator, source, permutations[submitted]) catch |err| {
+            submitError = err;
+            break;
+        };
+        // The scheduler copies the request strings, so the source can go now.
+        defer allocator.free(permutationSource);
+        const request = lib.compileRequest(permutationSource, entryPointName, stage);
+        if (!lib.CompileScheduler_submit(scheduler, &request, &jobs[submitted]).isSuccess()) {
+            submitError = error.FailedToSubmit;
+            break;
+        }
+    }
+
+    // Failed compiles are reported per permutation below; the batch result
+    // only repeats the first of them.
+    _ = lib.CompileScheduler_waitAll(scheduler, jobs[0..submitted], compileResults[0..submitted]);
+
+    var self: Self = .{
+        .allocator = allocator,
+        .blobs = .empty,
+        .indices = &.{},
+        .results = &.{},
+        .diagnostics = &.{},
+    };
+    var byDigest: std.AutoHashMapUnmanaged(Digest, u32) = .empty;
+    defer byDigest.deinit(allocator);
+    errdefer {
+        for (compileResults[0..submitted]) |result| {
+            _ = lib.release(result.code);
+            _ = lib.release(result.diagnostics);
+        }
+        self.deinit();
+    }
+    if (submitError) |err| return err;
+
+    // Reserve everything up front so ownership moves below cannot fail halfway.
+    self.indices = try allocator.alloc(?u32, permutations.len);
+    self.results = try allocator.alloc(lib.SlangResult, permutations.len);
+    self.diagnostics = try allocator.alloc(lib.IBlob, permutations.len);
+    @memset(self.diagnostics, null);
+    try self.blobs.ensureTotalCapacity(allocator, submitted);
+    try byDigest.ensureTotalCapacity(allocator, @intCast(submitted));
+
+    for (compileResults, 0..) |result, i| {
+        self.results[i] = @enumFromInt(result.result);
+        self.diagnostics[i] = result.diagnostics;
+        self.indices[i] = null;
+        if (result.code == null) continue;
+
+        var code: []const u8 = &.{};
+        _ = lib.getBlobSlice(result.code, &code);
+        var digest: Digest = undefined;
+        std.crypto.hash.sha2.Sha256.hash(code, &digest, .{});
+
+        const entry = byDigest.getOrPutAssumeCapacity(digest);
+        if (entry.found_existing) {
+            _ = lib.release(result.code);
+        } else {
+            entry.value_ptr.* = @intCast(self.blobs.items.len);
+            self.blobs.appendAssumeCapacity(result.code);
+        }
+        self.indices[i] = entry.value_ptr.*;
+    }
+
+    return self;
+}
+
+/// Like `compile`, on a scheduler created for this call only. `threadCount`
+/// zero means one worker per hardware thread.
+pub fn compileWithOwnScheduler(
+    allocator: std.mem.Allocator,
+    sessionDesc: *const lib.c.SessionDesc,
+    threadCount: u32,
+    source: []const u8,
+    entryPointName: [:0]const u8,
+    stage: lib.Stage,
+    permutations: []const []const Define,
+) Error!Self {
+    var scheduler: lib.CompileScheduler = null;
+    if (!lib.CompileScheduler_create(sessionDesc, threadCount, 0, null, &scheduler).isSuccess()) {
+        return error.FailedToCreateScheduler;
+    }
+    defer lib.CompileScheduler_destroy(scheduler);
+    return compile(allocator, scheduler, source, entryPointName, stage, permutations);
+}
+
+pub fn deinit(self: *Self) void {
+    for (self.blobs.items) |blob| _ = lib.release(blob);
+    for (self.diagnostics) |blob| _ = lib.release(blob);
+    self.blobs.deinit(self.allocator);
+    self.allocator.free(self.indices);
+    self.allocator.free(self.results);
+    self.allocator.free(self.diagnostics);
+    self.* = undefined;
+}
+
+pub fn getPermutationCount(self: *const Self) usize {
+    return self.indices.len;
+}
+
+/// Number of distinct outputs across all successful permutations.
+pub fn getUniqueCount(self: *const Self) usize {
+    return self.blobs.items.len;
+}
+
+/// Code for `permutation`, owned by the set, or null if it failed to compile.
+pub fn getCode(self: *const Self, permutation: usize) ?lib.IBlob {
+    const index = self.indices[permutation] orelse return null;
+    return self.blobs.items[index];
+}
+
+const testing = std.testing;
+
+test "VariantSet: expandAxes varies the last axis fastest" {
+    const axes = [_]Axis{
+        .{ .name = "A", .values = &.{ "0", "1" } },
+        .{ .name = "B", .values = &.{ "x", "y", "z" } },
+    };
+    const permutations = try expandAxes(testing.allocator, &axes);
+    defer freePermutations(testing.allocator, permutations);
+
+    try testing.expectEqual(@as(usize, 6), permutations.len);
+    const expected = [_][2][]const u8{
+        .{ "0", "x" }, .{ "0", "y" }, .{ "0", "z" },
+        .{ "1", "x" }, .{ "1", "y" }, .{ "1", "z" },
+    };
+    for (permutations, expected) |defines, values| {
+        try testing.expectEqual(@as(usize, 2), defines.len);
+        try testing.expectEqualStrings("A", defines[0].name);
+        try testing.expectEqualStrings(values[0], defines[0].value);
+        try testing.expectEqualStrings("B", defines[1].name);
+        try testing.expectEqualStrings(values[1], defines[1].value);
+    }
+}
+
+test "VariantSet: expandAxes rejects an axis without values" {
+    const axes = [_]Axis{
+        .{ .name = "A", .values = &.{"0"} },
+        .{ .name = "B", .values = &.{} },
+    };
+    try testing.expectError(error.InvalidArgument, expandAxes(testing.allocator, &axes));
+}
+
+test "VariantSet: expandAxes reports an overflowing permutation count" {
+    // Only the lengths are read before the count overflows.
+    const value: []const u8 = "0";
+    const many: [*]const []const u8 = @ptrCast(&value);
+    const huge = many[0 .. @as(usize, 1) << (@bitSizeOf(usize) / 2)];
+    const axes = [_]Axis{
+        .{ .name = "A", .values = huge },
+        .{ .name = "B", .values = huge },
+    };
+    try testing.expectError(error.OutOfMemory, expandAxes(testing.allocator, &axes));
+}
+
+test "VariantSet: buildSource prepends defines and resets the line counter" {
+    const defines = [_]Define{ .{ .name = "A" }, .{ .name = "B", .value = "2" } };
+    const source = try buildSource(testing.allocator, "void main() {}", &defines);
+    defer testing.allocator.free(source);
+    try testing.expectEqualStrings("#define A 1\n#define B 2\n#line 1\nvoid main() {}", source);
+}
+
+test "VariantSet: buildSource rejects malformed macros" {
+    const bad = [_]Define{
+        .{ .name = "" },
+        .{ .name = "A B" },
+        .{ .name = "F(x)" },
+        .{ .name = "A\nB" },
+        .{ .name = "A", .value = "1\n#define B 2" },
+    };
+    for (bad) |define| {
+        try testing.expectError(error.InvalidArgument, buildSource(testing.allocator, "", &.{define}));
+    }
+}
@@ -1,12 +1,83 @@
 #include "slang.h"
+#include "slangc_internal.h"
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <string>
 namespace slangc {
 #include "slangc.h"
 #include "slangc_types.h"
 } // namespace slangc
 
+namespace slangc_internal {
+SlangResult compileEntryPoint(slang::ISession *session, const char *moduleName,
+                              const char *source, const char *entryPointName,
+                              uint32_t stage, SlangInt targetIndex,
+                              ISlangBlob **outCode,
+                              ISlangBlob **outDiagnostics) {
+  DiagnosticsBuilder diagnostics;
+  ISlangBlob *phaseDiagnostics = nullptr;
+  *outCode = nullptr;
+
+  const std::string modulePath = std::string(moduleName) + ".slang";
+  slang::IModule *module = session->loadModuleFromSourceString(
+      moduleName, modulePath.c_str(), source, &phaseDiagnostics);
+  diagnostics.append(phaseDiagnostics);
+  if (!module) {
+    *outDiagnostics = diagnostics.finish();
+    return SLANG_FAIL;
+  }
+
+  slang::IEntryPoint *entryPoint = nullptr;
+  SlangResult result;
+  if (stage == SLANG_STAGE_NONE) {
+    result = module->findEntryPointByName(entryPointName, &entryPoint);
+  } else {
+    phaseDiagnostics = nullptr;
+    result = module->findAndCheckEntryPoint(entryPointName,
+                                            static_cast<SlangStage>(stage),
+                                            &entryPoint, &phaseDiagnostics);
+    diagnostics.append(phaseDiagnostics);
+  }
+
+  slang::IComponentType *composite = nullptr;
+  if (SLANG_SUCCEEDED(result)) {
+    slang::IComponentType *components[] = {module, entryPoint};
+    phaseDiagnostics = nullptr;
+    result = session->createCompositeComponentType(components, 2, &composite,
+                                                   &phaseDiagnostics);
+    diagnostics.append(phaseDiagnostics);
+  }
+
+  slang::IComponentType *linked = nullptr;
+  if (SLANG_SUCCEEDED(result)) {
+    phaseDiagnostics = nullptr;
+    result = composite->link(&linked, &phaseDiagnostics);
+    diagnostics.append(phaseDiagnostics);
+  }
+
+  if (SLANG_SUCCEEDED(result)) {
+    phaseDiagnostics = nullptr;
+    result = linked->getTargetCode(targetIndex, outCode, &phaseDiagnostics);
+    diagnostics.append(phaseDiagnostics);
+  }
+
+  if (linked) {
+    linked->release();
+  }
+  if (composite) {
+    composite->release();
+  }
+  if (entryPoint) {
+    entryPoint->release();
+  }
+  *outDiagnostics = diagnostics.finish();
+  return result;
+}
+} // namespace slangc_internal
+
 extern "C" {
 slangc::SlangResult
 createGlobalSession(slangc::IGlobalSession *outGlobalSession) {
@@ -46,6 +117,67 @@ SlangResult loadModuleFromSourceString(slangc::ISession inSession,
   return *module ? SLANG_OK : SLANG_FAIL;
 }
 
+SlangResult loadModuleFromSource(slangc::ISession inSession,
+                                 const char *moduleName, const char *path,
+                                 const void *source, size_t sourceSize,
+                                 slangc::ReleaseDataCallback releaseData,
+                                 void *userData, slangc::IModule *outModule,
+                                 slangc::IBlob *outDiagnostics) {
+  auto *session = (slang::ISession *)inSession;
+  auto **diagnostics = (slang::IBlob **)outDiagnostics;
+  auto **module = (slang::IModule **)outModule;
+
+  ISlangBlob *blob = slangc_internal::BorrowedBlob::create(
+      source, sourceSize, releaseData, userData);
+  *module = session->loadModuleFromSource(moduleName, path, blob, diagnostics);
+  blob->release();
+
+  return *module ? SLANG_OK : SLANG_FAIL;
+}
+
+SlangResult loadModuleFromIRBlob(slangc::ISession inSession,
+                                 const char *moduleName, const char *path,
+                                 const void *data, size_t size,
+                                 slangc::IModule *outModule,
+                                 slangc::IBlob *outDiagnostics) {
+  auto *session = (slang::ISession *)inSession;
+  auto **diagnostics = (slang::IBlob **)outDiagnostics;
+  auto **module = (slang::IModule **)outModule;
+
+  ISlangBlob *blob = slangc_internal::Blob::create(data, size);
+  *module = session->loadModuleFromIRBlob(moduleName, path, blob, diagnostics);
+  blob->release();
+
+  return *module ? SLANG_OK : SLANG_FAIL;
+}
+
+bool isBinaryModuleUpToDate(slangc::ISession inSession, const char *modulePath,
+                            const void *data, size_t size) {
+  auto *session = (slang::ISession *)inSession;
+
+  ISlangBlob *blob = slangc_internal::Blob::create(data, size);
+  const bool upToDate = session->isBinaryModuleUpToDate(modulePath, blob);
+  blob->release();
+
+  return upToDate;
+}
+
+SlangResult loadNamedModuleFromSourceString(slangc::ISession inSession,
+                                            const char *moduleName,
+                                            const char *path,
+                                            const char *sourceBuffer,
+                                            slangc::IModule *outModule,
+                                            slangc::IBlob *outDiagnostics) {
+  auto *session = (slang::ISession *)inSession;
+  auto **diagnostics = (slang::IBlob **)outDiagnostics;
+  auto **module = (slang::IModule **)outModule;
+
+  *module = session->loadModuleFromSourceString(moduleName, path, sourceBuffer,
+                                                diagnostics);
+
+  return *module ? SLANG_OK : SLANG_FAIL;
+}
+
 SlangResult createCompositeComponent(
     slangc::ISession inSession, const slangc::IComponentType *inComponentTypes,
     SlangInt componentTypeCount, slangc::IComponentType *outComposite,
@@ -89,6 +221,69 @@ SlangResult getTargetCode(slangc::IComponentType linkedProgram,
   return program->getTargetCode(0, output, diagnostics);
 }
 
+SlangResult getTargetCodeByIndex(slangc::IComponentType linkedProgram,
+                                 SlangInt targetIndex,
+                                 slangc::IBlob *outOutput,
+                                 slangc::IBlob *outDiagnostics) {
+  auto *program = (slang::IComponentType *)linkedProgram;
+  auto **output = (slang::IBlob **)outOutput;
+  auto **diagnostics = (slang::IBlob **)outDiagnostics;
+
+  return program->getTargetCode(targetIndex, output, diagnostics);
+}
+
+SlangResult getEntryPointCode(slangc::IComponentType linkedProgram,
+                              SlangInt entryPointIndex, SlangInt targetIndex,
+                              slangc::IBlob *outCode,
+                              slangc::IBlob *outDiagnostics) {
+  auto *program = (slang::IComponentType *)linkedProgram;
+  auto **code = (slang::IBlob **)outCode;
+  auto **diagnostics = (slang::IBlob **)outDiagnostics;
+
+  return program->getEntryPointCode(entryPointIndex, targetIndex, code,
+                                    diagnostics);
+}
+
+SlangResult getAllTargetCode(slangc::IComponentType linkedProgram,
+                             SlangInt targetCount, slangc::IBlob *outOutputs,
+                             SlangResult *outResults,
+                             slangc::IBlob *outDiagnostics) {
+  auto *program = (slang::IComponentType *)linkedProgram;
+  auto **outputs = (slang::IBlob **)outOutputs;
+  if (!program || targetCount < 0 || (targetCount > 0 && !outputs)) {
+    return SLANG_E_INVALID_ARG;
+  }
+  // ISession does not report its target count, but getLayout returns null
+  // for an index past the session's targets.
+  if (targetCount > 0 && !program->getLayout(targetCount - 1)) {
+    return SLANG_E_INVALID_ARG;
+  }
+
+  slangc_internal::DiagnosticsBuilder diagnostics;
+  SlangResult firstFailure = SLANG_OK;
+  for (SlangInt i = 0; i < targetCount; ++i) {
+    ISlangBlob *targetDiagnostics = nullptr;
+    outputs[i] = nullptr;
+    SlangResult result =
+        program->getTargetCode(i, &outputs[i], &targetDiagnostics);
+    diagnostics.append(targetDiagnostics);
+    if (outResults) {
+      outResults[i] = result;
+    }
+    if (SLANG_FAILED(result) && SLANG_SUCCEEDED(firstFailure)) {
+      firstFailure = result;
+    }
+  }
+
+  ISlangBlob *merged = diagnostics.finish();
+  if (outDiagnostics) {
+    *(slang::IBlob **)outDiagnostics = merged;
+  } else if (merged) {
+    merged->release();
+  }
+  return firstFailure;
+}
+
 SlangResult getBlobSlice(slangc::IBlob inBlob, const void **pointer,
                          size_t *size) {
   auto *blob = (slang::IBlob *)inBlob;
@@ -98,6 +293,89 @@ SlangResult getBlobSlice(slangc::IBlob inBlob, const void **pointer,
   return *pointer and *size ? SLANG_OK : SLANG_FAIL;
 }
 
+SlangResult copyTargetCode(slangc::IComponentType linkedProgram,
+                           SlangInt targetIndex, void *buffer,
+                           size_t bufferSize, size_t *outSize,
+                           slangc::IBlob *outDiagnostics) {
+  auto *program = (slang::IComponentType *)linkedProgram;
+  auto **diagnostics = (slang::IBlob **)outDiagnostics;
+  if (!program || !outSize || (!buffer && bufferSize > 0)) {
+    return SLANG_E_INVALID_ARG;
+  }
+
+  ISlangBlob *code = nullptr;
+  SlangResult result = program->getTargetCode(targetIndex, &code, diagnostics);
+  if (SLANG_FAILED(result)) {
+    return result;
+  }
+  const size_t size = code->getBufferSize();
+  *outSize = size;
+  if (size > bufferSize) {
+    code->release();
+    return SLANG_E_BUFFER_TOO_SMALL;
+  }
+  std::memcpy(buffer, code->getBufferPointer(), size);
+  code->release();
+  return SLANG_OK;
+}
+
+SlangResult compileBatch(slangc::ISession inSession,
+                         const slangc::CompileRequest *inRequests,
+                         SlangInt requestCount,
+                         slangc::CompileResult *outResults) {
+  auto *session = (slang::ISession *)inSession;
+  if (!session || requestCount < 0 ||
+      (requestCount > 0 && (!inRequests || !outResults))) {
+    return SLANG_E_INVALID_ARG;
+  }
+  // Module names must be unique per session, including across batches.
+  static std::atomic<uint64_t> moduleCounter{0};
+
+  SlangResult batchResult = SLANG_OK;
+  for (SlangInt i = 0; i < requestCount; ++i) {
+    const auto &request = inRequests[i];
+    auto &result = outResults[i];
+    if (!request.source || !request.entryPointName) {
+      result = {SLANG_E_INVALID_ARG, nullptr, nullptr};
+      if (SLANG_SUCCEEDED(batchResult)) {
+        batchResult = SLANG_E_INVALID_ARG;
+      }
+      continue;
+    }
+    const std::string moduleName =
+        "batch_module_" + std::to_string(moduleCounter++);
+
+    result.result = slangc_internal::compileEntryPoint(
+        session, moduleName.c_str(), request.source, request.entryPointName,
+        request.stage, request.targetIndex, (ISlangBlob **)&result.code,
+        (ISlangBlob **)&result.diagnostics);
+    if (SLANG_FAILED(result.result) && SLANG_SUCCEEDED(batchResult)) {
+      batchResult = result.result;
+    }
+  }
+  return batchResult;
+}
+
+SlangResult compileBatchInNewSession(slangc::IGlobalSession inGlobalSession,
+                                     const slangc::SessionDesc *inSessionDesc,
+                                     const slangc::CompileRequest *inRequests,
+                                     SlangInt requestCount,
+                                     slangc::CompileResult *outResults) {
+  if (!inGlobalSession || !inSessionDesc) {
+    return SLANG_E_INVALID_ARG;
+  }
+  slangc::ISession session = nullptr;
+  SlangResult result =
+      ::createSession(inGlobalSession, inSessionDesc, &session);
+  if (SLANG_FAILED(result)) {
+    return result;
+  }
+  // The result blobs hold no reference to the session, so they outlive it.
+  result = ::compileBatch(session, inRequests, requestCount, outResults);
+  ((slang::ISession *)session)->release();
+  return result;
+}
+
 unsigned ProgramLayout_getParameterCount(slangc::ProgramLayout layout) {
   auto *self = (slang::ProgramLayout *)layout;
   return self->getParameterCount();
@@ -1012,6 +1290,42 @@ slangc::SlangResult IMetadata_isParameterLocationUsed(
                                            spaceInt, registerInt, outUsed);
 }
 
+slangc::SlangResult IMetadata_getParameterUsage(
+    slangc::IMetadata inMetadata, slangc::ParameterCategory category,
+    slangc::SlangUInt spaceCount, slangc::SlangUInt registerCount,
+    uint64_t *outWords, slangc::SlangUInt wordCount) {
+  auto *metadata = (slang::IMetadata *)inMetadata;
+  if (!metadata ||
+      (registerCount != 0 && spaceCount > UINT64_MAX / registerCount)) {
+    return SLANG_E_INVALID_ARG;
+  }
+  const uint64_t bitCount = uint64_t(spaceCount) * registerCount;
+  const uint64_t neededWords = bitCount / 64 + (bitCount % 64 != 0);
+  if (wordCount < neededWords || (neededWords != 0 && !outWords)) {
+    return SLANG_E_BUFFER_TOO_SMALL;
+  }
+  if (neededWords != 0) {
+    std::memset(outWords, 0, size_t(neededWords) * sizeof(uint64_t));
+  }
+  // IMetadata has no enumeration API, so the probing stays on this side of
+  // the FFI boundary and callers get the whole range in one call.
+  uint64_t bit = 0;
+  for (slangc::SlangUInt space = 0; space < spaceCount; ++space) {
+    for (slangc::SlangUInt index = 0; index < registerCount; ++index, ++bit) {
+      bool used = false;
+      SlangResult result = metadata->isParameterLocationUsed(
+          SlangParameterCategory(category), space, index, used);
+      if (SLANG_FAILED(result)) {
+        return result;
+      }
+      if (used) {
+        outWords[bit / 64] |= uint64_t(1) << (bit % 64);
+      }
+    }
+  }
+  return SLANG_OK;
+}
+
 char const *AttributeReflection_getName(slangc::Attribute self) {
   auto *attribute = (slang::Attribute *)self;
   return attribute->getName();
@@ -1157,6 +1471,11 @@ slangc::SlangResult release(slangc::Unknown self) {
   return unknown->release();
 }
 
+uint32_t addRef(slangc::Unknown self) {
+  auto *unknown = (ISlangUnknown *)self;
+  return unknown->addRef();
+}
+
 SlangResult IModule_findEntryPointByName(slangc::IModule inModule,
                                          char const *name,
                                          slangc::IEntryPoint *inEntryPoint) {
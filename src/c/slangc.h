@@ -3,8 +3,22 @@
 
 typedef int32_t SlangResult;
 
+/** Hands borrowed bytes back to their owner once nothing refers to them any
+ * more, for example to munmap a memory-mapped file.
+ */
+typedef void (*ReleaseDataCallback)(const void *data, size_t size,
+                                    void *userData);
+
 SlangResult createGlobalSession(IGlobalSession *outGlobalSession);
 
+/** Like createGlobalSession, but loads the core module from the snapshot at
+ * `cachePath` instead of building it. When the snapshot is missing, corrupt or
+ * was written by a different Slang build, the core module is built as usual
+ * and a fresh snapshot is written for the next launch.
+ */
+SlangResult createGlobalSessionWithCoreModuleCache(
+    const char *cachePath, IGlobalSession *outGlobalSession);
+
 SlangResult createSession(IGlobalSession inGlobalSession,
                           const struct SessionDesc *inSessionDesc,
                           ISession *outSession);
@@ -17,6 +31,51 @@ SlangResult loadModuleFromSourceString(ISession inSession,
                                        IModule *outModule,
                                        IBlob *outDiagnostics);
 
+/** Loads a module from `sourceSize` bytes of source at `source`, which need
+ * not be NUL-terminated and is not copied. Slang keeps referring to the bytes
+ * for as long as the module lives; `releaseData` (optional) runs once it is
+ * done with them.
+ */
+SlangResult loadModuleFromSource(ISession inSession, const char *moduleName,
+                                 const char *path, const void *source,
+                                 size_t sourceSize,
+                                 ReleaseDataCallback releaseData,
+                                 void *userData, IModule *outModule,
+                                 IBlob *outDiagnostics);
+
+/** Loads a module serialized with IModule_serialize or IModule_writeToFile.
+ * The bytes are copied, so `data` may be freed once this returns.
+ */
+SlangResult loadModuleFromIRBlob(ISession inSession, const char *moduleName,
+                                 const char *path, const void *data,
+                                 size_t size, IModule *outModule,
+                                 IBlob *outDiagnostics);
+
+/** Checks a serialized module against the session's options and the current
+ * contents of the source files it was built from.
+ */
+bool isBinaryModuleUpToDate(ISession inSession, const char *modulePath,
+                            const void *data, size_t size);
+
+/** Loads `moduleName` the way an `import` would, then writes a fresh
+ * `.slang-module` for it into `cacheDirectory` when it had to be compiled from
+ * source. With `cacheDirectory` first on the session's search paths, later
+ * sessions load the binary instead of re-parsing the source; Slang only uses
+ * it when still up to date if the session sets UseUpToDateBinaryModule.
+ */
+SlangResult loadModuleWithBinaryCache(ISession inSession,
+                                      const char *cacheDirectory,
+                                      const char *moduleName,
+                                      IModule *outModule,
+                                      IBlob *outDiagnostics);
+
+SlangResult loadNamedModuleFromSourceString(ISession inSession,
+                                            const char *moduleName,
+                                            const char *path,
+                                            const char *sourceBuffer,
+                                            IModule *outModule,
+                                            IBlob *outDiagnostics);
+
 SlangResult createCompositeComponent(ISession inSession,
                                      const IComponentType *inComponentTypes,
                                      SlangInt componentTypeCount,
@@ -33,8 +92,573 @@ SlangResult getLayout(IComponentType inProgram, SlangInt targetIndex,
 SlangResult getTargetCode(IComponentType linkedProgram, IBlob *outOutput,
                           IBlob *outDiagnostics);
 
+SlangResult getTargetCodeByIndex(IComponentType linkedProgram,
+                                 SlangInt targetIndex, IBlob *outOutput,
+                                 IBlob *outDiagnostics);
+
+/** Generates code for a single entry point of `linkedProgram`, without
+ * emitting the program's other entry points.
+ */
+SlangResult getEntryPointCode(IComponentType linkedProgram,
+                              SlangInt entryPointIndex, SlangInt targetIndex,
+                              IBlob *outCode, IBlob *outDiagnostics);
+
+/** Generates code for targets [0, targetCount) of the session the program was
+ * linked in, reusing the single front-end pass and link. `outOutputs` and
+ * `outResults` (optional) have `targetCount` entries; diagnostics from every
+ * target are merged. Returns the first failure, or SLANG_E_INVALID_ARG when
+ * `targetCount` is negative or exceeds the session's target count.
+ */
+SlangResult getAllTargetCode(IComponentType linkedProgram,
+                             SlangInt targetCount, IBlob *outOutputs,
+                             SlangResult *outResults, IBlob *outDiagnostics);
+
 SlangResult getBlobSlice(IBlob inBlob, const void **pointer, size_t *size);
 
+/** Copies the code for `targetIndex` into `buffer`, which may be null when
+ * `bufferSize` is 0. `outSize` is required and receives the size of the code
+ * whenever generation succeeds; when the code does not fit, nothing is copied
+ * and SLANG_E_BUFFER_TOO_SMALL is returned. Null `linkedProgram` or `outSize`
+ * give SLANG_E_INVALID_ARG. Slang caches generated code per target, so
+ * querying the size first and copying afterwards compiles only once.
+ */
+SlangResult copyTargetCode(IComponentType linkedProgram, SlangInt targetIndex,
+                           void *buffer, size_t bufferSize, size_t *outSize,
+                           IBlob *outDiagnostics);
+
+/** Cost of one pipeline phase. `compilerSeconds` and `downstreamSeconds` are
+ * deltas of IGlobalSession::getCompilerElapsedTime, which is cumulative per
+ * global session, so they are only attributable to this call when no other
+ * thread compiles on the same global session meanwhile.
+ */
+struct PhaseTiming {
+  double wallSeconds;
+  double compilerSeconds;
+  double downstreamSeconds;
+};
+
+/** Front end (parse + semantic check) of one module.
+ */
+SlangResult loadNamedModuleFromSourceStringTimed(
+    ISession inSession, const char *moduleName, const char *path,
+    const char *sourceBuffer, IModule *outModule, IBlob *outDiagnostics,
+    struct PhaseTiming *outTiming);
+
+SlangResult linkProgramTimed(IComponentType inCompiledProgram,
+                             IComponentType *outLinkedProgram,
+                             IBlob *outDiagnostics,
+                             struct PhaseTiming *outTiming);
+
+SlangResult getTargetCodeTimed(IComponentType linkedProgram,
+                               SlangInt targetIndex, IBlob *outOutput,
+                               IBlob *outDiagnostics,
+                               struct PhaseTiming *outTiming);
+
+struct PerfBenchmarkEntry {
+  char name[64];
+  uint32_t invocationCount;
+  double milliseconds;
+};
+
+/** Extracts the per-function table that sessions created with
+ * ReportPerfBenchmark or ReportDetailedPerfBenchmark append to their
+ * diagnostics. `outCount` receives the number of entries found; when it
+ * exceeds `capacity` only the first `capacity` are written and
+ * SLANG_E_BUFFER_TOO_SMALL is returned.
+ */
+SlangResult parsePerfBenchmark(const char *text, size_t size,
+                               struct PerfBenchmarkEntry *outEntries,
+                               SlangInt capacity, SlangInt *outCount);
+
+struct CompileRequest {
+  /** NUL-terminated Slang source for the module.
+   */
+  const char *source;
+
+  /** Entry point to compile from the module.
+   */
+  const char *entryPointName;
+
+  /** Stage to check the entry point against, or SLANG_STAGE_NONE to use the
+   * stage declared by its `[shader(...)]` attribute.
+   */
+  SlangStageIntegral stage;
+
+  /** Index into SessionDesc.targets of the target to generate code for.
+   */
+  SlangInt targetIndex;
+};
+
+struct CompileResult {
+  SlangResult result;
+
+  /** Target code for the request's targetIndex, owned by the caller.
+   */
+  IBlob code;
+
+  /** Diagnostics from every phase of this request, owned by the caller. May be
+   * null when nothing was reported.
+   */
+  IBlob diagnostics;
+};
+
+/** Compiles each request as its own module in `inSession`. Slang cannot
+ * unload modules, so every request stays resident for the lifetime of the
+ * session; long-running callers should prefer compileBatchInNewSession.
+ */
+SlangResult compileBatch(ISession inSession,
+                         const struct CompileRequest *inRequests,
+                         SlangInt requestCount,
+                         struct CompileResult *outResults);
+
+/** Like compileBatch, but in a session created from `inSessionDesc` for this
+ * batch only, so its modules are freed before returning.
+ */
+SlangResult compileBatchInNewSession(IGlobalSession inGlobalSession,
+                                     const struct SessionDesc *inSessionDesc,
+                                     const struct CompileRequest *inRequests,
+                                     SlangInt requestCount,
+                                     struct CompileResult *outResults);
+
+/** ISlangFileSystem backed by an in-process map from normalized path to
+ * bytes. Pass it as SessionDesc.fileSystem so imports resolve without touching
+ * the disk. Safe to populate while sessions are reading from it. Created with
+ * a reference count of one; drop it with release().
+ */
+typedef void *MemoryFileSystem;
+
+SlangResult MemoryFileSystem_create(MemoryFileSystem *outFileSystem);
+
+/** Adds or replaces `path` with a copy of `data`.
+ */
+SlangResult MemoryFileSystem_addFile(MemoryFileSystem fileSystem,
+                                     const char *path, const void *data,
+                                     size_t size);
+
+/** Adds or replaces `path` with `data` without copying it, for example a
+ * memory-mapped file. `releaseData` (optional) runs once neither the file
+ * system nor any blob handed to Slang still refers to the bytes.
+ */
+SlangResult MemoryFileSystem_addBorrowedFile(
+    MemoryFileSystem fileSystem, const char *path, const void *data,
+    size_t size, ReleaseDataCallback releaseData, void *userData);
+
+bool MemoryFileSystem_removeFile(MemoryFileSystem fileSystem,
+                                 const char *path);
+
+SlangInt MemoryFileSystem_getFileCount(MemoryFileSystem fileSystem);
+
+typedef void *ModuleRegistry;
+
+/** Tracks the modules loaded into one session by name, so loading the same
+ * name and source again returns the existing IModule instead of parsing and
+ * checking it a second time. Like the session, a registry must only be used
+ * from one thread at a time.
+ */
+SlangResult ModuleRegistry_create(ISession inSession,
+                                  ModuleRegistry *outRegistry);
+
+void ModuleRegistry_destroy(ModuleRegistry registry);
+
+/** Returns the registered module for `moduleName` when its source digest
+ * matches, otherwise loads it. Loading a name that is already registered with
+ * different source fails, since a session cannot hold two modules of the same
+ * name. A null `path` defaults to "<moduleName>.slang". The returned module is
+ * owned by the session.
+ */
+SlangResult ModuleRegistry_load(ModuleRegistry registry,
+                                const char *moduleName, const char *path,
+                                const char *sourceBuffer, IModule *outModule,
+                                IBlob *outDiagnostics);
+
+/** Returns the module registered under `moduleName`, or null.
+ */
+IModule ModuleRegistry_find(ModuleRegistry registry, const char *moduleName);
+
+SlangInt ModuleRegistry_getCount(ModuleRegistry registry);
+
+typedef void *CompileScheduler;
+typedef void *CompileJob;
+
+struct CompileSchedulerDesc {
+  /** Number of workers. Zero means one per hardware thread.
+   */
+  uint32_t threadCount;
+
+  /** Number of jobs a worker compiles before replacing its session, which
+   * frees the modules those jobs loaded. Zero means each worker keeps one
+   * session, and every job's module, for the scheduler's lifetime.
+   */
+  uint32_t maxJobsPerSession;
+
+  /** Optional core module snapshot, as for
+   * createGlobalSessionWithCoreModuleCache. The core module is built or
+   * loaded once either way and shared with the other workers in serialized
+   * form.
+   */
+  const char *coreModuleCachePath;
+};
+
+/** Starts the workers, each owning a global session and a session created
+ * from a private copy of `inSessionDesc`. Returns once every worker session
+ * exists.
+ */
+SlangResult CompileScheduler_create(const struct SessionDesc *inSessionDesc,
+                                    const struct CompileSchedulerDesc *inDesc,
+                                    CompileScheduler *outScheduler);
+
+/** Drops queued jobs, waits for running ones and joins the workers. Jobs that
+ * were never waited on are freed along with their results.
+ */
+void CompileScheduler_destroy(CompileScheduler scheduler);
+
+uint32_t CompileScheduler_getThreadCount(CompileScheduler scheduler);
+
+/** Queues a compile. The request's strings are copied before returning.
+ */
+SlangResult CompileScheduler_submit(CompileScheduler scheduler,
+                                    const struct CompileRequest *inRequest,
+                                    CompileJob *outJob);
+
+/** Blocks until `job` finishes, moves its blobs into `outResult` and frees
+ * the job handle.
+ */
+SlangResult CompileScheduler_wait(CompileScheduler scheduler, CompileJob job,
+                                  struct CompileResult *outResult);
+
+SlangResult CompileScheduler_waitAll(CompileScheduler scheduler,
+                                     const CompileJob *jobs, SlangInt jobCount,
+                                     struct CompileResult *outResults);
+
+/** Called on the worker thread as soon as `job` finishes. The results stay
+ * with the job; collect them with CompileScheduler_tryWait, which no longer
+ * blocks at that point. `job` stays valid until the callback returns, even
+ * if another thread collects it in the meantime.
+ */
+typedef void (*CompileCallback)(CompileJob job, SlangResult result,
+                                void *userData);
+
+/** Like CompileScheduler_submit, with an optional completion callback.
+ */
+SlangResult CompileScheduler_submitAsync(CompileScheduler scheduler,
+                                         const struct CompileRequest *inRequest,
+                                         CompileCallback callback,
+                                         void *userData, CompileJob *outJob);
+
+/** Non-blocking CompileScheduler_wait: returns SLANG_E_PENDING and leaves the
+ * job alone while it is still queued or running.
+ */
+SlangResult CompileScheduler_tryWait(CompileScheduler scheduler, CompileJob job,
+                                     struct CompileResult *outResult);
+
+/** Returns a descriptor that polls readable after any job completes (eventfd
+ * on Linux, a pipe elsewhere), or -1 where unsupported. Reset it with
+ * CompileScheduler_acknowledgeCompletions before collecting finished jobs.
+ */
+int CompileScheduler_getCompletionFd(CompileScheduler scheduler);
+
+void CompileScheduler_acknowledgeCompletions(CompileScheduler scheduler);
+
+typedef void *SessionPool;
+
+struct SessionPoolDesc {
+  /** Modules loaded into every pooled session before it is handed out.
+   */
+  const char *const *preloadModules;
+  SlangInt preloadModuleCount;
+
+  /** Number of acquire/release cycles after which a session is retired.
+   * Zero means sessions are reused indefinitely.
+   */
+  uint32_t maxUsesPerSession;
+
+  /** Maximum idle sessions kept per distinct SessionDesc. Zero means
+   * unbounded.
+   */
+  uint32_t maxIdlePerKey;
+};
+
+/** Every pooled session gets a global session of its own, loaded from the
+ * core module of `inGlobalSession`, so sessions acquired by different threads
+ * can be used concurrently. `inGlobalSession` is only used during this call.
+ */
+SlangResult SessionPool_create(IGlobalSession inGlobalSession,
+                               const struct SessionPoolDesc *inDesc,
+                               SessionPool *outPool);
+
+/** Releases every session the pool created, including ones still acquired;
+ * callers must stop using acquired sessions before destroying the pool.
+ */
+void SessionPool_destroy(SessionPool pool);
+
+/** Creates `count` idle sessions for `inSessionDesc` ahead of time.
+ */
+SlangResult SessionPool_prewarm(SessionPool pool,
+                                const struct SessionDesc *inSessionDesc,
+                                uint32_t count, IBlob *outDiagnostics);
+
+/** Hands out an idle session created from an equivalent SessionDesc, or
+ * creates one. Sessions are keyed by the contents of the description and the
+ * identity of its file system. An acquired session belongs to the caller
+ * until SessionPool_release and must not be used from several threads at
+ * once.
+ */
+SlangResult SessionPool_acquire(SessionPool pool,
+                                const struct SessionDesc *inSessionDesc,
+                                ISession *outSession, IBlob *outDiagnostics);
+
+/** Returns an acquired session to the pool. Sessions that were not acquired
+ * from `pool`, or were already released, give SLANG_E_INVALID_HANDLE.
+ */
+SlangResult SessionPool_release(SessionPool pool, ISession inSession);
+
+SlangInt SessionPool_getIdleCount(SessionPool pool);
+
+typedef void *CompileCache;
+
+struct CompileCacheDesc {
+  /** Directory holding the cache entries. Created if it does not exist.
+   */
+  const char *directory;
+
+  /** Total size budget for cached entries, in bytes. Least recently used
+   * entries are evicted once it is exceeded. Zero means unbounded. A single
+   * entry larger than the budget is rejected by CompileCache_store.
+   */
+  uint64_t maxSizeBytes;
+
+  /** File system that dependency files are read through when hashing and
+   * validating entries; pass the SessionDesc.fileSystem of the sessions
+   * whose modules are stored, such as a MemoryFileSystem. Null reads them
+   * from disk. The cache holds a reference until it is closed.
+   */
+  void *fileSystem;
+};
+
+struct CompileCacheKey {
+  uint8_t bytes[32];
+};
+
+/** `inGlobalSession` may be null once the directory has been opened with one:
+ * the Slang build tag that keys depend on is recorded in the directory, so a
+ * warm start can look up cached code and reflection without creating a
+ * global session. Returns SLANG_E_NOT_FOUND if no tag was recorded yet.
+ */
+SlangResult CompileCache_open(IGlobalSession inGlobalSession,
+                              const struct CompileCacheDesc *inDesc,
+                              CompileCache *outCache);
+
+void CompileCache_close(CompileCache cache);
+
+SlangResult CompileCache_computeKey(CompileCache cache,
+                                    const struct SessionDesc *inSessionDesc,
+                                    const char *source, size_t sourceSize,
+                                    const char *entryPointName,
+                                    SlangStageIntegral stage,
+                                    SlangInt targetIndex,
+                                    struct CompileCacheKey *outKey);
+
+SlangResult CompileCache_load(CompileCache cache,
+                              const struct CompileCacheKey *key,
+                              IBlob *outCode, IBlob *outDiagnostics);
+
+/** Stores `code` (and optional `diagnostics`) under `key`. The files
+ * `inModule` depends on are hashed so a later edit makes the entry stale.
+ * Returns SLANG_E_BUFFER_TOO_SMALL without writing anything when the entry
+ * alone exceeds `maxSizeBytes`.
+ */
+SlangResult CompileCache_store(CompileCache cache,
+                               const struct CompileCacheKey *key,
+                               IModule inModule, IBlob code,
+                               IBlob diagnostics);
+
+/** Writes a reflection snapshot of `layout` (see writeReflectionSnapshot) to
+ * `<directory>/<hex key>.slrf`, next to the code stored under `key`, which
+ * must exist. The file is removed together with the entry when it is
+ * evicted or found stale, so load the code with CompileCache_load before
+ * mapping the snapshot.
+ */
+SlangResult CompileCache_storeReflection(CompileCache cache,
+                                         const struct CompileCacheKey *key,
+                                         ProgramLayout layout);
+
+uint64_t CompileCache_getTotalSize(CompileCache cache);
+
+/** Memoizes type, generic and function specialization against one program
+ * layout. Repeated requests with the same arguments return the pointer Slang
+ * handed out the first time without calling back into Slang. The layout (and
+ * the program that owns it) must outlive the cache. Failed specializations
+ * are not cached, so retrying reports their diagnostics again. Safe to use
+ * from several threads.
+ */
+typedef void *SpecializationCache;
+
+SlangResult SpecializationCache_create(ProgramLayout layout,
+                                       SpecializationCache *outCache);
+
+void SpecializationCache_destroy(SpecializationCache cache);
+
+TypeReflectionPtr SpecializationCache_specializeType(
+    SpecializationCache cache, TypeReflectionPtr inType, SlangInt argCount,
+    TypeReflectionPtr const *args, IBlob *outDiagnostics);
+
+GenericReflectionPtr SpecializationCache_specializeGeneric(
+    SpecializationCache cache, GenericReflectionPtr inGeneric,
+    SlangInt argCount, enum GenericArgType const *argTypes,
+    union GenericArgReflectionPtr const *argVals, IBlob *outDiagnostics);
+
+FunctionReflectionPtr SpecializationCache_specializeFunction(
+    SpecializationCache cache, FunctionReflectionPtr inFunction,
+    unsigned int argCount, TypeReflectionPtr const *argTypes);
+
+/** Bulk variants: `setCount` argument sets of `argCount` entries each, laid
+ * out back to back. Every set is attempted; failed ones leave null in their
+ * output slot and make the call return SLANG_FAIL. Diagnostics from all sets
+ * are concatenated.
+ */
+SlangResult SpecializationCache_specializeTypes(
+    SpecializationCache cache, TypeReflectionPtr inType, SlangInt setCount,
+    SlangInt argCount, TypeReflectionPtr const *args,
+    TypeReflectionPtr *outTypes, IBlob *outDiagnostics);
+
+SlangResult SpecializationCache_specializeGenerics(
+    SpecializationCache cache, GenericReflectionPtr inGeneric,
+    SlangInt setCount, SlangInt argCount, enum GenericArgType const *argTypes,
+    union GenericArgReflectionPtr const *argVals,
+    GenericReflectionPtr *outGenerics, IBlob *outDiagnostics);
+
+SlangResult SpecializationCache_specializeFunctions(
+    SpecializationCache cache, FunctionReflectionPtr inFunction,
+    SlangInt setCount, unsigned int argCount,
+    TypeReflectionPtr const *argTypes, FunctionReflectionPtr *outFunctions);
+
+SlangInt SpecializationCache_getEntryCount(SpecializationCache cache);
+
+/* Flat reflection snapshot. The buffer starts with a ReflectionSnapshotHeader
+ * followed by 8-byte aligned arrays of the records below. Records refer to
+ * each other by array index and to names by byte offset into the string
+ * section (offset 0 is the empty string); SLANGC_REFLECTION_NONE marks a
+ * missing reference. Type layouts are shared: every distinct layout appears
+ * once.
+ */
+#define SLANGC_REFLECTION_SNAPSHOT_MAGIC 0x46524c53u /* "SLRF" */
+#define SLANGC_REFLECTION_SNAPSHOT_VERSION 1u
+#define SLANGC_REFLECTION_NONE 0xffffffffu
+
+struct ReflectionSnapshotSection {
+  uint32_t offset;
+  uint32_t count;
+};
+
+struct ReflectionSnapshotHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t totalSize;
+  struct ReflectionSnapshotSection types;
+  struct ReflectionSnapshotSection variables;
+  struct ReflectionSnapshotSection bindingRanges;
+  struct ReflectionSnapshotSection descriptorSets;
+  struct ReflectionSnapshotSection descriptorRanges;
+  struct ReflectionSnapshotSection entryPoints;
+  /** `count` is the size of the string section in bytes. */
+  struct ReflectionSnapshotSection strings;
+  /** Global parameters are variables[parameterFirst, +parameterCount). */
+  uint32_t parameterFirst;
+  uint32_t parameterCount;
+  uint32_t globalParamsType;
+  uint32_t globalConstantBufferBinding;
+  uint64_t globalConstantBufferSize;
+};
+
+struct ReflectionSnapshotType {
+  uint32_t name;
+  uint32_t kind;
+  uint32_t scalarType;
+  uint32_t parameterCategory;
+  uint64_t uniformSize;
+  uint64_t uniformStride;
+  uint32_t uniformAlignment;
+  uint32_t rowCount;
+  uint32_t columnCount;
+  uint32_t resourceShape;
+  uint32_t resourceAccess;
+  uint32_t elementType;
+  uint64_t elementCount;
+  /** variables[fieldFirst, +fieldCount) */
+  uint32_t fieldFirst;
+  uint32_t fieldCount;
+  /** bindingRanges[bindingRangeFirst, +bindingRangeCount) */
+  uint32_t bindingRangeFirst;
+  uint32_t bindingRangeCount;
+  /** descriptorSets[descriptorSetFirst, +descriptorSetCount) */
+  uint32_t descriptorSetFirst;
+  uint32_t descriptorSetCount;
+};
+
+struct ReflectionSnapshotVariable {
+  uint32_t name;
+  uint32_t type;
+  uint32_t category;
+  uint32_t bindingIndex;
+  uint32_t bindingSpace;
+  uint32_t semanticName;
+  uint32_t semanticIndex;
+  uint32_t reserved;
+  uint64_t uniformOffset;
+};
+
+/** `descriptorSetIndex` and `firstDescriptorRange` are relative to the owning
+ * type's descriptor sets, as in TypeLayoutReflection.
+ */
+struct ReflectionSnapshotBindingRange {
+  uint32_t bindingType;
+  uint32_t leafType;
+  int64_t bindingCount;
+  uint32_t descriptorSetIndex;
+  uint32_t firstDescriptorRange;
+  uint32_t descriptorRangeCount;
+  uint32_t reserved;
+};
+
+struct ReflectionSnapshotDescriptorSet {
+  uint32_t spaceOffset;
+  /** descriptorRanges[descriptorRangeFirst, +descriptorRangeCount) */
+  uint32_t descriptorRangeFirst;
+  uint32_t descriptorRangeCount;
+  uint32_t reserved;
+};
+
+struct ReflectionSnapshotDescriptorRange {
+  uint32_t indexOffset;
+  uint32_t bindingType;
+  uint32_t category;
+  uint32_t reserved;
+  int64_t descriptorCount;
+};
+
+#define SLANGC_ENTRY_POINT_USES_SAMPLE_RATE_INPUT 0x1u
+#define SLANGC_ENTRY_POINT_HAS_DEFAULT_CONSTANT_BUFFER 0x2u
+
+struct ReflectionSnapshotEntryPoint {
+  uint32_t name;
+  uint32_t stage;
+  uint64_t threadGroupSize[3];
+  /** variables[parameterFirst, +parameterCount) */
+  uint32_t parameterFirst;
+  uint32_t parameterCount;
+  uint32_t resultVariable;
+  uint32_t flags;
+};
+
+/** Walks the whole of `layout` once and writes a snapshot into `buffer`
+ * (8-byte aligned; may be null when `bufferSize` is 0). `outSize` always
+ * receives the snapshot size; when it does not fit, nothing is written and
+ * SLANG_E_BUFFER_TOO_SMALL is returned. Passing a generous buffer up front
+ * avoids walking the layout twice.
+ */
+SlangResult writeReflectionSnapshot(ProgramLayout layout, void *buffer,
+                                    size_t bufferSize, size_t *outSize);
+
 unsigned ProgramLayout_getParameterCount(ProgramLayout layout);
 
 unsigned ProgramLayout_getTypeParameterCount(ProgramLayout layout);
@@ -446,6 +1070,21 @@ SlangResult IMetadata_isParameterLocationUsed(IMetadata inMetadata,
                                               SlangUInt registerInt,
                                               bool *outUsed);
 
+/** Writes a bitset of the `category` locations the entry point behind
+ * `inMetadata` uses, covering spaces [0, spaceCount) and registers
+ * [0, registerCount). Location (space, register) is bit
+ * `space * registerCount + register`, packed into 64-bit words from the least
+ * significant bit. `outWords` must hold at least
+ * `(spaceCount * registerCount + 63) / 64` words, otherwise
+ * SLANG_E_BUFFER_TOO_SMALL is returned; bits past the last location are zero.
+ */
+SlangResult IMetadata_getParameterUsage(IMetadata inMetadata,
+                                        enum ParameterCategory category,
+                                        SlangUInt spaceCount,
+                                        SlangUInt registerCount,
+                                        uint64_t *outWords,
+                                        SlangUInt wordCount);
+
 char const *AttributeReflection_getName(Attribute self);
 
 uint32_t AttributeReflection_getArgumentCount(Attribute self);
@@ -512,6 +1151,8 @@ FunctionReflectionPtr FunctionReflection_getOverload(FunctionReflectionPtr self,
 
 SlangResult release(Unknown self);
 
+uint32_t addRef(Unknown self);
+
 SlangResult IModule_findEntryPointByName(IModule inModule, char const *name,
                                          IEntryPoint *inEntryPoint);
 
@@ -0,0 +1,76 @@
+#include "slang.h"
+#include "slangc_internal.h"
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+namespace slangc {
+#include "slangc.h"
+} // namespace slangc
+
+namespace {
+namespace fs = std::filesystem;
+
+constexpr const char *kBinaryModuleExtension = ".slang-module";
+
+// Mirrors how `import a.b_c` is resolved to `a/b-c.slang`, so the binary lands
+// where the search-path lookup for the module will look for it.
+fs::path binaryModulePath(const char *cacheDirectory, const char *moduleName) {
+  std::string relative = moduleName;
+  for (char &ch : relative) {
+    if (ch == '.') {
+      ch = '/';
+    } else if (ch == '_') {
+      ch = '-';
+    }
+  }
+  return fs::path(cacheDirectory) / (relative + kBinaryModuleExtension);
+}
+
+bool hasBinaryModuleExtension(const char *path) {
+  const size_t length = std::strlen(path);
+  const size_t extensionLength = std::strlen(kBinaryModuleExtension);
+  return length >= extensionLength &&
+         std::strcmp(path + length - extensionLength, kBinaryModuleExtension) ==
+             0;
+}
+} // namespace
+
+extern "C" {
+slangc::SlangResult loadModuleWithBinaryCache(slangc::ISession inSession,
+                                              const char *cacheDirectory,
+                                              const char *moduleName,
+                                              slangc::IModule *outModule,
+                                              slangc::IBlob *outDiagnostics) {
+  if (!inSession || !cacheDirectory || !moduleName || !outModule) {
+    return SLANG_E_INVALID_ARG;
+  }
+  auto *session = (slang::ISession *)inSession;
+  auto **diagnostics = (slang::IBlob **)outDiagnostics;
+  auto **module = (slang::IModule **)outModule;
+
+  *module = session->loadModule(moduleName, diagnostics);
+  if (!*module) {
+    return SLANG_FAIL;
+  }
+
+  const char *filePath = (*module)->getFilePath();
+  if (filePath && hasBinaryModuleExtension(filePath)) {
+    return SLANG_OK;
+  }
+
+  // The module was compiled from source; a failed write only means the next
+  // session compiles it again.
+  ISlangBlob *serialized = nullptr;
+  if (SLANG_SUCCEEDED((*module)->serialize(&serialized))) {
+    const fs::path path = binaryModulePath(cacheDirectory, moduleName);
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    slangc_internal::writeFileAtomic(path,
+                                     {{serialized->getBufferPointer(),
+                                       serialized->getBufferSize()}});
+    serialized->release();
+  }
+  return SLANG_OK;
+}
+}
@@ -0,0 +1,501 @@
+#include "slang.h"
+#include "slangc_internal.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+namespace slangc {
+#include "slangc.h"
+} // namespace slangc
+
+namespace {
+namespace fs = std::filesystem;
+using slangc_internal::Blob;
+using slangc_internal::readFile;
+using slangc_internal::Sha256;
+
+// Bump whenever the key derivation changes so old entries stop matching.
+constexpr uint32_t kKeyVersion = 1;
+
+constexpr uint32_t kEntryMagic = 0x43434c53; // "SLCC"
+constexpr uint32_t kEntryVersion = 1;
+constexpr const char *kEntryExtension = ".slcc";
+// Reflection snapshots sit next to their entry under the same name.
+constexpr const char *kReflectionExtension = ".slrf";
+// Build tag of the last Slang that opened the directory, so the cache can be
+// opened later without creating a global session.
+constexpr const char *kBuildTagFile = "BUILD_TAG";
+
+// On-disk entry layout:
+//   EntryHeader
+//   dependencyCount x { uint32_t pathSize, char path[pathSize], digest[32] }
+//   code bytes
+//   diagnostics bytes
+// `payloadDigest` covers everything after the header.
+struct EntryHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t dependencyCount;
+  uint32_t reserved;
+  uint64_t codeSize;
+  uint64_t diagnosticsSize;
+  uint8_t payloadDigest[Sha256::kDigestSize];
+};
+
+void digestBytes(const void *data, size_t size,
+                 uint8_t out[Sha256::kDigestSize]) {
+  Sha256 hasher;
+  hasher.update(data, size);
+  hasher.finish(out);
+}
+
+void appendBytes(std::vector<uint8_t> &out, const void *data, size_t size) {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  out.insert(out.end(), bytes, bytes + size);
+}
+
+class DiskCache {
+public:
+  DiskCache(fs::path directory, uint64_t maxSizeBytes, std::string buildTag,
+            ISlangFileSystem *fileSystem)
+      : m_directory(std::move(directory)), m_maxSizeBytes(maxSizeBytes),
+        m_buildTag(std::move(buildTag)), m_fileSystem(fileSystem) {
+    if (m_fileSystem) {
+      m_fileSystem->addRef();
+    }
+  }
+
+  ~DiskCache() {
+    if (m_fileSystem) {
+      m_fileSystem->release();
+    }
+  }
+
+  // Rebuilds the in-memory index from the directory, ordering entries by
+  // modification time so LRU order survives restarts. Reflection files left
+  // without an entry, e.g. by a crash mid-eviction, are deleted.
+  void scan() {
+    std::vector<std::pair<fs::file_time_type, std::pair<std::string, uint64_t>>>
+        found;
+    std::vector<fs::path> reflections;
+    std::error_code ec;
+    for (const auto &item : fs::directory_iterator(m_directory, ec)) {
+      if (!item.is_regular_file(ec)) {
+        continue;
+      }
+      if (item.path().extension() == kReflectionExtension) {
+        reflections.push_back(item.path());
+        continue;
+      }
+      if (item.path().extension() != kEntryExtension) {
+        continue;
+      }
+      const uint64_t size = item.file_size(ec);
+      const auto time = item.last_write_time(ec);
+      found.push_back({time, {item.path().stem().string(), size}});
+    }
+    std::sort(found.begin(), found.end(),
+              [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &item : found) {
+      insertLocked(item.second.first, item.second.second);
+    }
+    evictLocked();
+    for (const fs::path &path : reflections) {
+      if (m_entries.find(path.stem().string()) == m_entries.end()) {
+        fs::remove(path, ec);
+      }
+    }
+  }
+
+  void computeKey(const slang::SessionDesc &desc, const char *source,
+                  size_t sourceSize, const char *entryPointName,
+                  uint32_t stage, SlangInt targetIndex,
+                  uint8_t out[Sha256::kDigestSize]) const {
+    Sha256 hasher;
+    hasher.updateValue(kKeyVersion);
+    hasher.updateString(m_buildTag.c_str());
+    slangc_internal::hashSessionDesc(hasher, desc);
+    hasher.updateValue(uint64_t(sourceSize));
+    hasher.update(source, sourceSize);
+    hasher.updateString(entryPointName);
+    hasher.updateValue(stage);
+    hasher.updateValue(int64_t(targetIndex));
+    hasher.finish(out);
+  }
+
+  SlangResult load(const std::string &name, ISlangBlob **outCode,
+                   ISlangBlob **outDiagnostics) {
+    const fs::path path = pathFor(name);
+    std::vector<uint8_t> bytes;
+    if (!readFile(path, bytes)) {
+      return SLANG_E_NOT_FOUND;
+    }
+
+    size_t codeOffset = 0;
+    EntryHeader header;
+    SlangResult result = validate(bytes, header, codeOffset);
+    if (SLANG_FAILED(result)) {
+      if (result != SLANG_E_NOT_FOUND) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        removeLocked(name);
+      }
+      return SLANG_E_NOT_FOUND;
+    }
+
+    const uint8_t *code = bytes.data() + codeOffset;
+    *outCode = Blob::create(code, size_t(header.codeSize));
+    if (outDiagnostics) {
+      *outDiagnostics =
+          header.diagnosticsSize
+              ? Blob::create(code + header.codeSize,
+                             size_t(header.diagnosticsSize))
+              : nullptr;
+    }
+
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) {
+      // Written by another process sharing the directory.
+      insertLocked(name, bytes.size());
+      evictLocked();
+    } else {
+      m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+    }
+    return SLANG_OK;
+  }
+
+  SlangResult store(const std::string &name, slang::IModule *module,
+                    ISlangBlob *code, ISlangBlob *diagnostics) {
+    std::vector<uint8_t> payload;
+    uint32_t dependencyCount = 0;
+    if (module) {
+      std::vector<uint8_t> contents;
+      for (SlangInt32 i = 0; i < module->getDependencyFileCount(); ++i) {
+        const char *dependency = module->getDependencyFilePath(i);
+        // Sources passed in as strings have no backing file; their content is
+        // already part of the key.
+        if (!dependency || !readDependency(dependency, contents)) {
+          continue;
+        }
+        const uint32_t pathSize = uint32_t(std::strlen(dependency));
+        uint8_t digest[Sha256::kDigestSize];
+        digestBytes(contents.data(), contents.size(), digest);
+        appendBytes(payload, &pathSize, sizeof(pathSize));
+        appendBytes(payload, dependency, pathSize);
+        appendBytes(payload, digest, sizeof(digest));
+        ++dependencyCount;
+      }
+    }
+
+    EntryHeader header = {};
+    header.magic = kEntryMagic;
+    header.version = kEntryVersion;
+    header.dependencyCount = dependencyCount;
+    header.codeSize = code->getBufferSize();
+    header.diagnosticsSize = diagnostics ? diagnostics->getBufferSize() : 0;
+    appendBytes(payload, code->getBufferPointer(), size_t(header.codeSize));
+    if (diagnostics) {
+      appendBytes(payload, diagnostics->getBufferPointer(),
+                  size_t(header.diagnosticsSize));
+    }
+    digestBytes(payload.data(), payload.size(), header.payloadDigest);
+
+    // An entry over the whole budget would be evicted as soon as it is
+    // inserted, so refuse it before touching the disk.
+    const uint64_t entrySize = sizeof(header) + payload.size();
+    if (m_maxSizeBytes && entrySize > m_maxSizeBytes) {
+      return SLANG_E_BUFFER_TOO_SMALL;
+    }
+
+    SlangResult result = slangc_internal::writeFileAtomic(
+        pathFor(name),
+        {{&header, sizeof(header)}, {payload.data(), payload.size()}});
+    if (SLANG_FAILED(result)) {
+      return result;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    eraseLocked(name);
+    insertLocked(name, entrySize);
+    evictLocked();
+    return SLANG_OK;
+  }
+
+  // Reflection files are small next to the code and are not counted against
+  // the size budget; they are removed together with their entry.
+  SlangResult storeReflection(const std::string &name,
+                              slang::ProgramLayout *layout) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_entries.find(name) == m_entries.end()) {
+        return SLANG_E_NOT_FOUND;
+      }
+    }
+    std::vector<uint8_t> snapshot;
+    SlangResult result =
+        slangc_internal::buildReflectionSnapshot(layout, snapshot);
+    if (SLANG_FAILED(result)) {
+      return result;
+    }
+    result = slangc_internal::writeFileAtomic(
+        reflectionPathFor(name), {{snapshot.data(), snapshot.size()}});
+    if (SLANG_FAILED(result)) {
+      return result;
+    }
+    // The entry may have been evicted while the file was written, after
+    // eviction already tried to remove its reflection.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.find(name) == m_entries.end()) {
+      std::error_code ec;
+      fs::remove(reflectionPathFor(name), ec);
+      return SLANG_E_NOT_FOUND;
+    }
+    return SLANG_OK;
+  }
+
+  uint64_t totalSize() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_totalSize;
+  }
+
+private:
+  struct Entry {
+    uint64_t size;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  fs::path pathFor(const std::string &name) const {
+    return m_directory / (name + kEntryExtension);
+  }
+
+  fs::path reflectionPathFor(const std::string &name) const {
+    return m_directory / (name + kReflectionExtension);
+  }
+
+  // Dependencies resolve through the same file system as the sessions that
+  // imported them, so in-memory sources invalidate entries like disk files.
+  bool readDependency(const char *path, std::vector<uint8_t> &out) const {
+    if (!m_fileSystem) {
+      return readFile(path, out);
+    }
+    ISlangBlob *blob = nullptr;
+    if (SLANG_FAILED(m_fileSystem->loadFile(path, &blob)) || !blob) {
+      return false;
+    }
+    const auto *bytes = static_cast<const uint8_t *>(blob->getBufferPointer());
+    out.assign(bytes, bytes + blob->getBufferSize());
+    blob->release();
+    return true;
+  }
+
+  // Returns SLANG_E_NOT_FOUND for stale entries (a dependency changed) and
+  // SLANG_FAIL for corrupt ones.
+  SlangResult validate(const std::vector<uint8_t> &bytes,
+                              EntryHeader &header, size_t &codeOffset) {
+    if (bytes.size() < sizeof(EntryHeader)) {
+      return SLANG_FAIL;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != kEntryMagic || header.version != kEntryVersion) {
+      return SLANG_FAIL;
+    }
+
+    const uint8_t *payload = bytes.data() + sizeof(header);
+    const size_t payloadSize = bytes.size() - sizeof(header);
+    uint8_t digest[Sha256::kDigestSize];
+    digestBytes(payload, payloadSize, digest);
+    if (std::memcmp(digest, header.payloadDigest, sizeof(digest)) != 0) {
+      return SLANG_FAIL;
+    }
+
+    size_t offset = 0;
+    std::vector<uint8_t> contents;
+    for (uint32_t i = 0; i < header.dependencyCount; ++i) {
+      uint32_t pathSize = 0;
+      if (offset + sizeof(pathSize) > payloadSize) {
+        return SLANG_FAIL;
+      }
+      std::memcpy(&pathSize, payload + offset, sizeof(pathSize));
+      offset += sizeof(pathSize);
+      if (offset + pathSize + Sha256::kDigestSize > payloadSize) {
+        return SLANG_FAIL;
+      }
+      const std::string path((const char *)payload + offset, pathSize);
+      offset += pathSize;
+      if (!readDependency(path.c_str(), contents)) {
+        return SLANG_E_NOT_FOUND;
+      }
+      digestBytes(contents.data(), contents.size(), digest);
+      if (std::memcmp(digest, payload + offset, sizeof(digest)) != 0) {
+        return SLANG_E_NOT_FOUND;
+      }
+      offset += Sha256::kDigestSize;
+    }
+
+    if (payloadSize - offset != header.codeSize + header.diagnosticsSize) {
+      return SLANG_FAIL;
+    }
+    codeOffset = sizeof(header) + offset;
+    return SLANG_OK;
+  }
+
+  void insertLocked(const std::string &name, uint64_t size) {
+    m_lru.push_front(name);
+    m_entries[name] = Entry{size, m_lru.begin()};
+    m_totalSize += size;
+  }
+
+  void eraseLocked(const std::string &name) {
+    auto it = m_entries.find(name);
+    if (it == m_entries.end()) {
+      return;
+    }
+    m_totalSize -= it->second.size;
+    m_lru.erase(it->second.lruPosition);
+    m_entries.erase(it);
+  }
+
+  void removeLocked(const std::string &name) {
+    eraseLocked(name);
+    std::error_code ec;
+    fs::remove(pathFor(name), ec);
+    fs::remove(reflectionPathFor(name), ec);
+  }
+
+  void evictLocked() {
+    while (m_maxSizeBytes && m_totalSize > m_maxSizeBytes && !m_lru.empty()) {
+      removeLocked(m_lru.back());
+    }
+  }
+
+  std::mutex m_mutex;
+  const fs::path m_directory;
+  const uint64_t m_maxSizeBytes;
+  const std::string m_buildTag;
+  ISlangFileSystem *const m_fileSystem;
+  std::list<std::string> m_lru; // most recently used first
+  std::unordered_map<std::string, Entry> m_entries;
+  uint64_t m_totalSize = 0;
+};
+
+std::string keyName(const slangc::CompileCacheKey *key) {
+  return slangc_internal::toHex(key->bytes, sizeof(key->bytes));
+}
+} // namespace
+
+extern "C" {
+slangc::SlangResult CompileCache_open(slangc::IGlobalSession inGlobalSession,
+                                      const slangc::CompileCacheDesc *inDesc,
+                                      slangc::CompileCache *outCache) {
+  auto *globalSession = (slang::IGlobalSession *)inGlobalSession;
+  if (!inDesc || !inDesc->directory || !outCache) {
+    return SLANG_E_INVALID_ARG;
+  }
+
+  std::error_code ec;
+  fs::create_directories(inDesc->directory, ec);
+  if (ec) {
+    return SLANG_E_CANNOT_OPEN;
+  }
+
+  // The build tag pins entries to the Slang SDK that produced them. Without a
+  // global session, fall back to the tag recorded by the last open that had
+  // one.
+  const fs::path tagPath = fs::path(inDesc->directory) / kBuildTagFile;
+  std::vector<uint8_t> recordedTag;
+  const bool hasRecordedTag = readFile(tagPath, recordedTag);
+  std::string buildTag;
+  if (globalSession) {
+    const char *tag = globalSession->getBuildTagString();
+    buildTag = tag ? tag : "";
+    if (!hasRecordedTag ||
+        std::string(recordedTag.begin(), recordedTag.end()) != buildTag) {
+      slangc_internal::writeFileAtomic(tagPath,
+                                       {{buildTag.data(), buildTag.size()}});
+    }
+  } else if (hasRecordedTag) {
+    buildTag.assign(recordedTag.begin(), recordedTag.end());
+  } else {
+    return SLANG_E_NOT_FOUND;
+  }
+  auto *cache =
+      new DiskCache(inDesc->directory, inDesc->maxSizeBytes, buildTag,
+                    (ISlangFileSystem *)inDesc->fileSystem);
+  cache->scan();
+  *outCache = cache;
+  return SLANG_OK;
+}
+
+void CompileCache_close(slangc::CompileCache cache) {
+  delete (DiskCache *)cache;
+}
+
+slangc::SlangResult CompileCache_computeKey(
+    slangc::CompileCache cache, const slangc::SessionDesc *inSessionDesc,
+    const char *source, size_t sourceSize, const char *entryPointName,
+    slangc::SlangStageIntegral stage, SlangInt targetIndex,
+    slangc::CompileCacheKey *outKey) {
+  auto *self = (DiskCache *)cache;
+  if (!self || !inSessionDesc || (!source && sourceSize) || !outKey) {
+    return SLANG_E_INVALID_ARG;
+  }
+  const auto &sessionDesc = *(const slang::SessionDesc *)inSessionDesc;
+  self->computeKey(sessionDesc, source, sourceSize, entryPointName, stage,
+                   targetIndex, outKey->bytes);
+  return SLANG_OK;
+}
+
+slangc::SlangResult CompileCache_load(slangc::CompileCache cache,
+                                      const slangc::CompileCacheKey *key,
+                                      slangc::IBlob *outCode,
+                                      slangc::IBlob *outDiagnostics) {
+  auto *self = (DiskCache *)cache;
+  auto **code = (ISlangBlob **)outCode;
+  auto **diagnostics = (ISlangBlob **)outDiagnostics;
+  if (!self || !key || !code) {
+    return SLANG_E_INVALID_ARG;
+  }
+  return self->load(keyName(key), code, diagnostics);
+}
+
+slangc::SlangResult CompileCache_store(slangc::CompileCache cache,
+                                       const slangc::CompileCacheKey *key,
+                                       slangc::IModule inModule,
+                                       slangc::IBlob code,
+                                       slangc::IBlob diagnostics) {
+  auto *self = (DiskCache *)cache;
+  if (!self || !key || !code) {
+    return SLANG_E_INVALID_ARG;
+  }
+  return self->store(keyName(key), (slang::IModule *)inModule,
+                     (ISlangBlob *)code, (ISlangBlob *)diagnostics);
+}
+
+slangc::SlangResult
+CompileCache_storeReflection(slangc::CompileCache cache,
+                             const slangc::CompileCacheKey *key,
+                             slangc::ProgramLayout layout) {
+  auto *self = (DiskCache *)cache;
+  if (!self || !key || !layout) {
+    return SLANG_E_INVALID_ARG;
+  }
+  return self->storeReflection(keyName(key), (slang::ProgramLayout *)layout);
+}
+
+uint64_t CompileCache_getTotalSize(slangc::CompileCache cache) {
+  auto *self = (DiskCache *)cache;
+  return self ? self->totalSize() : 0;
+}
+}
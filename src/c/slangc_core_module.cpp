@@ -0,0 +1,158 @@
+#include "slang.h"
+#include "slangc_internal.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+namespace slangc {
+#include "slangc.h"
+} // namespace slangc
+
+namespace {
+namespace fs = std::filesystem;
+using slangc_internal::Sha256;
+
+constexpr uint32_t kSnapshotMagic = 0x4d434c53; // "SLCM"
+constexpr uint32_t kSnapshotVersion = 1;
+
+// On-disk snapshot layout:
+//   SnapshotHeader
+//   char buildTag[buildTagSize]
+//   archive bytes from IGlobalSession::saveCoreModule
+// `dataDigest` covers the archive bytes only.
+struct SnapshotHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t buildTagSize;
+  uint32_t reserved;
+  uint64_t dataSize;
+  uint8_t dataDigest[Sha256::kDigestSize];
+};
+
+// Returns the archive bytes of `bytes` if it is an intact snapshot written by
+// the same Slang build, or null.
+const uint8_t *validateSnapshot(const std::vector<uint8_t> &bytes,
+                                const char *buildTag, size_t *outSize) {
+  SnapshotHeader header;
+  if (bytes.size() < sizeof(header)) {
+    return nullptr;
+  }
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  const size_t tagSize = std::strlen(buildTag);
+  if (header.magic != kSnapshotMagic || header.version != kSnapshotVersion ||
+      header.buildTagSize != tagSize ||
+      bytes.size() != sizeof(header) + tagSize + header.dataSize) {
+    return nullptr;
+  }
+  const uint8_t *tag = bytes.data() + sizeof(header);
+  if (std::memcmp(tag, buildTag, tagSize) != 0) {
+    return nullptr;
+  }
+  const uint8_t *data = tag + tagSize;
+  uint8_t digest[Sha256::kDigestSize];
+  Sha256 hasher;
+  hasher.update(data, size_t(header.dataSize));
+  hasher.finish(digest);
+  if (std::memcmp(digest, header.dataDigest, sizeof(digest)) != 0) {
+    return nullptr;
+  }
+  *outSize = size_t(header.dataSize);
+  return data;
+}
+
+SlangResult writeSnapshot(const fs::path &path, const char *buildTag,
+                          ISlangBlob *archive) {
+  SnapshotHeader header = {};
+  header.magic = kSnapshotMagic;
+  header.version = kSnapshotVersion;
+  header.buildTagSize = uint32_t(std::strlen(buildTag));
+  header.dataSize = archive->getBufferSize();
+  Sha256 hasher;
+  hasher.update(archive->getBufferPointer(), archive->getBufferSize());
+  hasher.finish(header.dataDigest);
+
+  std::error_code ec;
+  if (path.has_parent_path()) {
+    fs::create_directories(path.parent_path(), ec);
+  }
+  return slangc_internal::writeFileAtomic(
+      path, {{&header, sizeof(header)},
+             {buildTag, header.buildTagSize},
+             {archive->getBufferPointer(), archive->getBufferSize()}});
+}
+} // namespace
+
+namespace slangc_internal {
+SlangResult createGlobalSessionFromCoreModule(
+    ISlangBlob *coreModule, slang::IGlobalSession **outGlobalSession) {
+  if (coreModule) {
+    slang::IGlobalSession *globalSession = nullptr;
+    if (SLANG_SUCCEEDED(slang_createGlobalSessionWithoutCoreModule(
+            SLANG_API_VERSION, &globalSession))) {
+      if (SLANG_SUCCEEDED(
+              globalSession->loadCoreModule(coreModule->getBufferPointer(),
+                                            coreModule->getBufferSize()))) {
+        *outGlobalSession = globalSession;
+        return SLANG_OK;
+      }
+      globalSession->release();
+    }
+  }
+  return slang_createGlobalSession(SLANG_API_VERSION, outGlobalSession);
+}
+} // namespace slangc_internal
+
+extern "C" {
+slangc::SlangResult
+createGlobalSessionWithCoreModuleCache(const char *cachePath,
+                                       slangc::IGlobalSession *outGlobalSession) {
+  if (!cachePath || !outGlobalSession) {
+    return SLANG_E_INVALID_ARG;
+  }
+  const fs::path path(cachePath);
+  slang::IGlobalSession *globalSession = nullptr;
+  SlangResult result = slang_createGlobalSessionWithoutCoreModule(
+      SLANG_API_VERSION, &globalSession);
+  if (SLANG_FAILED(result)) {
+    return result;
+  }
+
+  std::vector<uint8_t> bytes;
+  if (slangc_internal::readFile(path, bytes)) {
+    size_t size = 0;
+    const uint8_t *data =
+        validateSnapshot(bytes, globalSession->getBuildTagString(), &size);
+    if (data && SLANG_SUCCEEDED(globalSession->loadCoreModule(data, size))) {
+      *outGlobalSession = globalSession;
+      return SLANG_OK;
+    }
+    // A snapshot that fails to load may leave the session half initialized;
+    // start over from a clean one.
+    globalSession->release();
+    globalSession = nullptr;
+    result = slang_createGlobalSessionWithoutCoreModule(SLANG_API_VERSION,
+                                                        &globalSession);
+    if (SLANG_FAILED(result)) {
+      return result;
+    }
+  }
+
+  result = globalSession->compileCoreModule(0);
+  if (SLANG_FAILED(result)) {
+    globalSession->release();
+    return result;
+  }
+
+  // Failing to write the snapshot only costs the next launch its fast path.
+  ISlangBlob *archive = nullptr;
+  if (SLANG_SUCCEEDED(globalSession->saveCoreModule(SLANG_ARCHIVE_TYPE_RIFF_LZ4,
+                                                    &archive))) {
+    writeSnapshot(path, globalSession->getBuildTagString(), archive);
+    archive->release();
+  }
+  *outGlobalSession = globalSession;
+  return SLANG_OK;
+}
+}
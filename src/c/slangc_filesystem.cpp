@@ -0,0 +1,223 @@
+#include "slang.h"
+#include "slangc_internal.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+namespace slangc {
+#include "slangc.h"
+} // namespace slangc
+
+namespace {
+// Contents of one file, either copied in or borrowed from the caller (for
+// example a memory-mapped region) and handed back through `releaseData`.
+struct FileData {
+  std::vector<uint8_t> owned;
+  const void *data = nullptr;
+  size_t size = 0;
+  slangc::ReleaseDataCallback releaseData = nullptr;
+  void *userData = nullptr;
+
+  ~FileData() {
+    if (releaseData) {
+      releaseData(data, size, userData);
+    }
+  }
+};
+
+// Blob sharing a file's bytes without copying them. It keeps the contents
+// alive even if the file is replaced or removed while Slang still holds it.
+class FileBlob final : public ISlangBlob {
+public:
+  explicit FileBlob(std::shared_ptr<const FileData> file)
+      : m_file(std::move(file)) {}
+
+  SLANG_NO_THROW SlangResult SLANG_MCALL
+  queryInterface(SlangUUID const &uuid, void **outObject) override {
+    if (uuid == ISlangUnknown::getTypeGuid() ||
+        uuid == ISlangBlob::getTypeGuid()) {
+      addRef();
+      *outObject = static_cast<ISlangBlob *>(this);
+      return SLANG_OK;
+    }
+    *outObject = nullptr;
+    return SLANG_E_NO_INTERFACE;
+  }
+
+  SLANG_NO_THROW uint32_t SLANG_MCALL addRef() override { return ++m_refCount; }
+
+  SLANG_NO_THROW uint32_t SLANG_MCALL release() override {
+    uint32_t count = --m_refCount;
+    if (count == 0) {
+      delete this;
+    }
+    return count;
+  }
+
+  SLANG_NO_THROW const void *SLANG_MCALL getBufferPointer() override {
+    return m_file->data;
+  }
+
+  SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() override {
+    return m_file->size;
+  }
+
+private:
+  std::shared_ptr<const FileData> m_file;
+  std::atomic<uint32_t> m_refCount{0};
+};
+
+// Paths are compared after lexical normalization, so "./a/../b.slang" and
+// "b.slang" name the same file regardless of how a search path was spelled.
+std::string normalizePath(const char *path) {
+  std::string text = path;
+  for (char &ch : text) {
+    if (ch == '\\') {
+      ch = '/';
+    }
+  }
+  std::string normal =
+      std::filesystem::path(text).lexically_normal().generic_string();
+  while (normal.size() > 2 && normal.compare(0, 2, "./") == 0) {
+    normal.erase(0, 2);
+  }
+  return normal;
+}
+
+class MemoryFileSystem final : public ISlangFileSystem {
+public:
+  SLANG_NO_THROW SlangResult SLANG_MCALL
+  queryInterface(SlangUUID const &uuid, void **outObject) override {
+    void *object = getInterface(uuid);
+    *outObject = object;
+    if (!object) {
+      return SLANG_E_NO_INTERFACE;
+    }
+    addRef();
+    return SLANG_OK;
+  }
+
+  SLANG_NO_THROW uint32_t SLANG_MCALL addRef() override { return ++m_refCount; }
+
+  SLANG_NO_THROW uint32_t SLANG_MCALL release() override {
+    uint32_t count = --m_refCount;
+    if (count == 0) {
+      delete this;
+    }
+    return count;
+  }
+
+  SLANG_NO_THROW void *SLANG_MCALL castAs(const SlangUUID &guid) override {
+    return getInterface(guid);
+  }
+
+  SLANG_NO_THROW SlangResult SLANG_MCALL
+  loadFile(char const *path, ISlangBlob **outBlob) override {
+    std::shared_ptr<const FileData> file;
+    {
+      std::shared_lock<std::shared_mutex> lock(m_mutex);
+      auto it = m_files.find(normalizePath(path));
+      if (it == m_files.end()) {
+        return SLANG_E_NOT_FOUND;
+      }
+      file = it->second;
+    }
+    auto *blob = new FileBlob(std::move(file));
+    blob->addRef();
+    *outBlob = blob;
+    return SLANG_OK;
+  }
+
+  void add(const char *path, std::shared_ptr<const FileData> file) {
+    std::string key = normalizePath(path);
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_files[std::move(key)] = std::move(file);
+  }
+
+  bool remove(const char *path) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    return m_files.erase(normalizePath(path)) != 0;
+  }
+
+  SlangInt count() {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return SlangInt(m_files.size());
+  }
+
+private:
+  void *getInterface(const SlangUUID &guid) {
+    if (guid == ISlangUnknown::getTypeGuid() ||
+        guid == ISlangCastable::getTypeGuid() ||
+        guid == ISlangFileSystem::getTypeGuid()) {
+      return static_cast<ISlangFileSystem *>(this);
+    }
+    return nullptr;
+  }
+
+  std::atomic<uint32_t> m_refCount{0};
+  std::shared_mutex m_mutex;
+  std::unordered_map<std::string, std::shared_ptr<const FileData>> m_files;
+};
+} // namespace
+
+extern "C" {
+slangc::SlangResult
+MemoryFileSystem_create(slangc::MemoryFileSystem *outFileSystem) {
+  if (!outFileSystem) {
+    return SLANG_E_INVALID_ARG;
+  }
+  auto *fileSystem = new MemoryFileSystem();
+  fileSystem->addRef();
+  *outFileSystem = static_cast<ISlangFileSystem *>(fileSystem);
+  return SLANG_OK;
+}
+
+slangc::SlangResult
+MemoryFileSystem_addFile(slangc::MemoryFileSystem fileSystem, const char *path,
+                         const void *data, size_t size) {
+  if (!fileSystem || !path || (size > 0 && !data)) {
+    return SLANG_E_INVALID_ARG;
+  }
+  auto file = std::make_shared<FileData>();
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  file->owned.assign(bytes, bytes + size);
+  file->data = file->owned.data();
+  file->size = size;
+  static_cast<MemoryFileSystem *>((ISlangFileSystem *)fileSystem)
+      ->add(path, std::move(file));
+  return SLANG_OK;
+}
+
+slangc::SlangResult MemoryFileSystem_addBorrowedFile(
+    slangc::MemoryFileSystem fileSystem, const char *path, const void *data,
+    size_t size, slangc::ReleaseDataCallback releaseData,
+    void *userData) {
+  if (!fileSystem || !path || (size > 0 && !data)) {
+    return SLANG_E_INVALID_ARG;
+  }
+  auto file = std::make_shared<FileData>();
+  file->data = data;
+  file->size = size;
+  file->releaseData = releaseData;
+  file->userData = userData;
+  static_cast<MemoryFileSystem *>((ISlangFileSystem *)fileSystem)
+      ->add(path, std::move(file));
+  return SLANG_OK;
+}
+
+bool MemoryFileSystem_removeFile(slangc::MemoryFileSystem fileSystem,
+                                 const char *path) {
+  return static_cast<MemoryFileSystem *>((ISlangFileSystem *)fileSystem)
+      ->remove(path);
+}
+
+SlangInt MemoryFileSystem_getFileCount(slangc::MemoryFileSystem fileSystem) {
+  return static_cast<MemoryFileSystem *>((ISlangFileSystem *)fileSystem)
+      ->count();
+}
+}
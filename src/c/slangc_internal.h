@@ -0,0 +1,495 @@
+#pragma once
+// Helpers shared between the shim translation units. C++ only; never included
+// from the C header that Zig imports.
+#include "slang.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace slangc_internal {
+
+// Minimal ref-counted ISlangBlob that owns a copy of its bytes.
+class Blob final : public ISlangBlob {
+public:
+  static ISlangBlob *create(std::vector<uint8_t> &&bytes) {
+    auto *blob = new Blob();
+    blob->m_bytes = std::move(bytes);
+    blob->addRef();
+    return blob;
+  }
+
+  static ISlangBlob *create(const void *data, size_t size) {
+    const auto *begin = static_cast<const uint8_t *>(data);
+    return create(std::vector<uint8_t>(begin, begin + size));
+  }
+
+  SLANG_NO_THROW SlangResult SLANG_MCALL
+  queryInterface(SlangUUID const &uuid, void **outObject) override {
+    if (uuid == ISlangUnknown::getTypeGuid() ||
+        uuid == ISlangBlob::getTypeGuid()) {
+      addRef();
+      *outObject = static_cast<ISlangBlob *>(this);
+      return SLANG_OK;
+    }
+    *outObject = nullptr;
+    return SLANG_E_NO_INTERFACE;
+  }
+
+  SLANG_NO_THROW uint32_t SLANG_MCALL addRef() override { return ++m_refCount; }
+
+  SLANG_NO_THROW uint32_t SLANG_MCALL release() override {
+    uint32_t count = --m_refCount;
+    if (count == 0) {
+      delete this;
+    }
+    return count;
+  }
+
+  SLANG_NO_THROW const void *SLANG_MCALL getBufferPointer() override {
+    return m_bytes.data();
+  }
+
+  SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() override {
+    return m_bytes.size();
+  }
+
+private:
+  Blob() = default;
+
+  std::atomic<uint32_t> m_refCount{0};
+  std::vector<uint8_t> m_bytes;
+};
+
+// SHA-256, used wherever the shim needs a content address.
+class Sha256 {
+public:
+  static constexpr size_t kDigestSize = 32;
+
+  Sha256() { reset(); }
+
+  void reset() {
+    static const uint32_t kInit[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+                                      0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                      0x1f83d9ab, 0x5be0cd19};
+    std::memcpy(m_state, kInit, sizeof(m_state));
+    m_length = 0;
+    m_bufferSize = 0;
+  }
+
+  void update(const void *data, size_t size) {
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    m_length += size;
+    while (size > 0) {
+      size_t take = 64 - m_bufferSize;
+      if (take > size) {
+        take = size;
+      }
+      std::memcpy(m_buffer + m_bufferSize, bytes, take);
+      m_bufferSize += take;
+      bytes += take;
+      size -= take;
+      if (m_bufferSize == 64) {
+        compress(m_buffer);
+        m_bufferSize = 0;
+      }
+    }
+  }
+
+  // Length-prefixed so that adjacent fields cannot alias each other.
+  void updateString(const char *str) {
+    if (!str) {
+      updateValue<uint64_t>(UINT64_MAX);
+      return;
+    }
+    const uint64_t size = std::strlen(str);
+    updateValue(size);
+    update(str, size);
+  }
+
+  template <typename T> void updateValue(const T &value) {
+    update(&value, sizeof(value));
+  }
+
+  void finish(uint8_t out[kDigestSize]) {
+    const uint64_t bitLength = m_length * 8;
+    const uint8_t pad = 0x80;
+    const uint8_t zero = 0;
+    update(&pad, 1);
+    while (m_bufferSize != 56) {
+      update(&zero, 1);
+    }
+    uint8_t lengthBytes[8];
+    for (int i = 0; i < 8; ++i) {
+      lengthBytes[i] = uint8_t(bitLength >> (56 - 8 * i));
+    }
+    update(lengthBytes, 8);
+    for (int i = 0; i < 8; ++i) {
+      out[4 * i + 0] = uint8_t(m_state[i] >> 24);
+      out[4 * i + 1] = uint8_t(m_state[i] >> 16);
+      out[4 * i + 2] = uint8_t(m_state[i] >> 8);
+      out[4 * i + 3] = uint8_t(m_state[i]);
+    }
+  }
+
+private:
+  static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+  void compress(const uint8_t block[64]) {
+    static const uint32_t k[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+        0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+        0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+        0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+        0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+        0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+        0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+        0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+        0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+      w[i] = (uint32_t(block[4 * i]) << 24) | (uint32_t(block[4 * i + 1]) << 16) |
+             (uint32_t(block[4 * i + 2]) << 8) | uint32_t(block[4 * i + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+      uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+    uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+    for (int i = 0; i < 64; ++i) {
+      uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+      uint32_t ch = (e & f) ^ (~e & g);
+      uint32_t t1 = h + s1 + ch + k[i] + w[i];
+      uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+      uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      uint32_t t2 = s0 + maj;
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+    m_state[0] += a;
+    m_state[1] += b;
+    m_state[2] += c;
+    m_state[3] += d;
+    m_state[4] += e;
+    m_state[5] += f;
+    m_state[6] += g;
+    m_state[7] += h;
+  }
+
+  uint32_t m_state[8];
+  uint64_t m_length;
+  uint8_t m_buffer[64];
+  size_t m_bufferSize;
+};
+
+inline std::string toHex(const uint8_t *bytes, size_t size) {
+  static const char kDigits[] = "0123456789abcdef";
+  std::string out(size * 2, '0');
+  for (size_t i = 0; i < size; ++i) {
+    out[2 * i] = kDigits[bytes[i] >> 4];
+    out[2 * i + 1] = kDigits[bytes[i] & 0xf];
+  }
+  return out;
+}
+
+inline bool readFile(const std::filesystem::path &path,
+                     std::vector<uint8_t> &out) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  const std::streamoff size = file.tellg();
+  if (size < 0) {
+    return false;
+  }
+  out.resize(size_t(size));
+  file.seekg(0);
+  return size == 0 || bool(file.read((char *)out.data(), size));
+}
+
+struct ByteSpan {
+  const void *data;
+  size_t size;
+};
+
+// Writes `parts` back to back into a private temporary next to `path` and
+// renames it into place, so readers never observe a partially written file.
+inline SlangResult writeFileAtomic(const std::filesystem::path &path,
+                                   std::initializer_list<ByteSpan> parts) {
+  static std::atomic<uint64_t> counter{0};
+  std::filesystem::path temporary = path;
+  temporary += ".tmp" +
+               std::to_string(std::hash<std::thread::id>{}(
+                   std::this_thread::get_id())) +
+               "." + std::to_string(counter++);
+  std::error_code ec;
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return SLANG_E_CANNOT_OPEN;
+    }
+    for (const ByteSpan &part : parts) {
+      file.write((const char *)part.data, std::streamsize(part.size));
+    }
+    if (!file) {
+      file.close();
+      std::filesystem::remove(temporary, ec);
+      return SLANG_FAIL;
+    }
+  }
+  std::filesystem::rename(temporary, path, ec);
+  if (ec) {
+    std::filesystem::remove(temporary, ec);
+    return SLANG_FAIL;
+  }
+  return SLANG_OK;
+}
+
+inline void hashCompilerOptions(Sha256 &hasher,
+                                const slang::CompilerOptionEntry *entries,
+                                uint32_t count) {
+  hasher.updateValue(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    const auto &entry = entries[i];
+    hasher.updateValue(int32_t(entry.name));
+    hasher.updateValue(int32_t(entry.value.kind));
+    hasher.updateValue(entry.value.intValue0);
+    hasher.updateValue(entry.value.intValue1);
+    hasher.updateString(entry.value.stringValue0);
+    hasher.updateString(entry.value.stringValue1);
+  }
+}
+
+// Ref-counted ISlangBlob over bytes it does not own. `releaseData`, when set,
+// runs with `userData` after the last reference goes away.
+class BorrowedBlob final : public ISlangBlob {
+public:
+  using ReleaseData = void (*)(const void *data, size_t size, void *userData);
+
+  static ISlangBlob *create(const void *data, size_t size,
+                            ReleaseData releaseData, void *userData) {
+    auto *blob = new BorrowedBlob();
+    blob->m_data = data;
+    blob->m_size = size;
+    blob->m_releaseData = releaseData;
+    blob->m_userData = userData;
+    blob->addRef();
+    return blob;
+  }
+
+  ~BorrowedBlob() {
+    if (m_releaseData) {
+      m_releaseData(m_data, m_size, m_userData);
+    }
+  }
+
+  SLANG_NO_THROW SlangResult SLANG_MCALL
+  queryInterface(SlangUUID const &uuid, void **outObject) override {
+    if (uuid == ISlangUnknown::getTypeGuid() ||
+        uuid == ISlangBlob::getTypeGuid()) {
+      addRef();
+      *outObject = static_cast<ISlangBlob *>(this);
+      return SLANG_OK;
+    }
+    *outObject = nullptr;
+    return SLANG_E_NO_INTERFACE;
+  }
+
+  SLANG_NO_THROW uint32_t SLANG_MCALL addRef() override { return ++m_refCount; }
+
+  SLANG_NO_THROW uint32_t SLANG_MCALL release() override {
+    uint32_t count = --m_refCount;
+    if (count == 0) {
+      delete this;
+    }
+    return count;
+  }
+
+  SLANG_NO_THROW const void *SLANG_MCALL getBufferPointer() override {
+    return m_data;
+  }
+
+  SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() override { return m_size; }
+
+private:
+  BorrowedBlob() = default;
+
+  const void *m_data = nullptr;
+  size_t m_size = 0;
+  ReleaseData m_releaseData = nullptr;
+  void *m_userData = nullptr;
+  std::atomic<uint32_t> m_refCount{0};
+};
+
+// Feeds every field of a session description into `hasher`, field by field,
+// so that padding bytes and pointer values never leak into the digest.
+inline void hashSessionDesc(Sha256 &hasher, const slang::SessionDesc &desc) {
+  hasher.updateValue(int64_t(desc.targetCount));
+  for (SlangInt i = 0; i < desc.targetCount; ++i) {
+    const auto &target = desc.targets[i];
+    hasher.updateValue(int32_t(target.format));
+    hasher.updateValue(uint32_t(target.profile));
+    hasher.updateValue(uint32_t(target.flags));
+    hasher.updateValue(uint32_t(target.floatingPointMode));
+    hasher.updateValue(uint32_t(target.lineDirectiveMode));
+    hasher.updateValue(uint8_t(target.forceGLSLScalarBufferLayout));
+    hashCompilerOptions(hasher, target.compilerOptionEntries,
+                        target.compilerOptionEntryCount);
+  }
+  hasher.updateValue(uint32_t(desc.flags));
+  hasher.updateValue(uint32_t(desc.defaultMatrixLayoutMode));
+  hasher.updateValue(int64_t(desc.searchPathCount));
+  for (SlangInt i = 0; i < desc.searchPathCount; ++i) {
+    hasher.updateString(desc.searchPaths[i]);
+  }
+  hasher.updateValue(int64_t(desc.preprocessorMacroCount));
+  for (SlangInt i = 0; i < desc.preprocessorMacroCount; ++i) {
+    hasher.updateString(desc.preprocessorMacros[i].name);
+    hasher.updateString(desc.preprocessorMacros[i].value);
+  }
+  hasher.updateValue(uint8_t(desc.enableEffectAnnotations));
+  hasher.updateValue(uint8_t(desc.allowGLSLSyntax));
+  hashCompilerOptions(hasher, desc.compilerOptionEntries,
+                      desc.compilerOptionEntryCount);
+  hasher.updateValue(uint8_t(desc.skipSPIRVValidation));
+}
+
+// Deep copy of a SessionDesc, so sessions can be created from it long after
+// the caller's arrays and strings are gone.
+class SessionDescStorage {
+public:
+  explicit SessionDescStorage(const slang::SessionDesc &desc) : m_desc(desc) {
+    m_targets.assign(desc.targets, desc.targets + desc.targetCount);
+    m_targetOptions.resize(m_targets.size());
+    for (size_t i = 0; i < m_targets.size(); ++i) {
+      m_targetOptions[i] = copyOptions(m_targets[i].compilerOptionEntries,
+                                       m_targets[i].compilerOptionEntryCount);
+      m_targets[i].compilerOptionEntries = m_targetOptions[i].data();
+    }
+    for (SlangInt i = 0; i < desc.searchPathCount; ++i) {
+      m_searchPaths.push_back(copyString(desc.searchPaths[i]));
+    }
+    for (SlangInt i = 0; i < desc.preprocessorMacroCount; ++i) {
+      m_macros.push_back({copyString(desc.preprocessorMacros[i].name),
+                          copyString(desc.preprocessorMacros[i].value)});
+    }
+    m_options =
+        copyOptions(desc.compilerOptionEntries, desc.compilerOptionEntryCount);
+
+    m_desc.targets = m_targets.data();
+    m_desc.searchPaths = m_searchPaths.data();
+    m_desc.preprocessorMacros = m_macros.data();
+    m_desc.compilerOptionEntries = m_options.data();
+    if (m_desc.fileSystem) {
+      m_desc.fileSystem->addRef();
+    }
+  }
+
+  ~SessionDescStorage() {
+    if (m_desc.fileSystem) {
+      m_desc.fileSystem->release();
+    }
+  }
+
+  SessionDescStorage(const SessionDescStorage &) = delete;
+  SessionDescStorage &operator=(const SessionDescStorage &) = delete;
+
+  const slang::SessionDesc &get() const { return m_desc; }
+
+private:
+  const char *copyString(const char *str) {
+    if (!str) {
+      return nullptr;
+    }
+    m_strings.emplace_back(str);
+    return m_strings.back().c_str();
+  }
+
+  std::vector<slang::CompilerOptionEntry>
+  copyOptions(const slang::CompilerOptionEntry *entries, uint32_t count) {
+    std::vector<slang::CompilerOptionEntry> out(entries, entries + count);
+    for (auto &entry : out) {
+      entry.value.stringValue0 = copyString(entry.value.stringValue0);
+      entry.value.stringValue1 = copyString(entry.value.stringValue1);
+    }
+    return out;
+  }
+
+  slang::SessionDesc m_desc;
+  std::deque<std::string> m_strings;
+  std::vector<slang::TargetDesc> m_targets;
+  std::vector<std::vector<slang::CompilerOptionEntry>> m_targetOptions;
+  std::vector<slang::CompilerOptionEntry> m_options;
+  std::vector<const char *> m_searchPaths;
+  std::vector<slang::PreprocessorMacroDesc> m_macros;
+};
+
+// Concatenates the diagnostics of several pipeline phases into one blob.
+class DiagnosticsBuilder {
+public:
+  // Takes ownership of `blob`, which may be null.
+  void append(ISlangBlob *blob) {
+    if (!blob) {
+      return;
+    }
+    const auto *text = static_cast<const char *>(blob->getBufferPointer());
+    size_t size = blob->getBufferSize();
+    // Diagnostic blobs are NUL-terminated strings; keep a single terminator.
+    while (size > 0 && text[size - 1] == '\0') {
+      --size;
+    }
+    m_text.append(text, size);
+    blob->release();
+  }
+
+  ISlangBlob *finish() {
+    if (m_text.empty()) {
+      return nullptr;
+    }
+    return Blob::create(m_text.c_str(), m_text.size() + 1);
+  }
+
+private:
+  std::string m_text;
+};
+
+// Runs load -> find entry point -> compose -> link -> codegen for a single
+// entry point in `session`. Defined in slangc.cpp.
+SlangResult compileEntryPoint(slang::ISession *session, const char *moduleName,
+                              const char *source, const char *entryPointName,
+                              uint32_t stage, SlangInt targetIndex,
+                              ISlangBlob **outCode,
+                              ISlangBlob **outDiagnostics);
+
+// Creates a global session that loads its core module from `coreModule`, a
+// saveCoreModule archive, and builds it instead when `coreModule` is null or
+// fails to load. Defined in slangc_core_module.cpp.
+SlangResult createGlobalSessionFromCoreModule(
+    ISlangBlob *coreModule, slang::IGlobalSession **outGlobalSession);
+
+// Writes the writeReflectionSnapshot bytes for `layout` into `out`. Defined in
+// slangc_reflection_snapshot.cpp.
+SlangResult buildReflectionSnapshot(slang::ProgramLayout *layout,
+                                    std::vector<uint8_t> &out);
+
+} // namespace slangc_internal
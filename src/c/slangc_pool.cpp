@@ -0,0 +1,265 @@
+#include "slang.h"
+#include "slangc_internal.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+namespace slangc {
+#include "slangc.h"
+} // namespace slangc
+
+namespace {
+struct PooledSession {
+  std::string key;
+  // Owned by this session alone, so sessions handed to different threads
+  // share no Slang state.
+  slang::IGlobalSession *globalSession = nullptr;
+  uint32_t uses = 0;
+  bool acquired = false;
+};
+
+// Idle sessions grouped by a digest of the SessionDesc they were created
+// from. Sessions are handed out to one caller at a time; the pool itself may
+// be used from any thread. A global session is not thread-safe, so every
+// pooled session gets its own, loaded from a serialized copy of the caller's
+// core module.
+class SessionPool {
+public:
+  SessionPool(slang::IGlobalSession *globalSession,
+              const slangc::SessionPoolDesc &desc)
+      : m_maxUses(desc.maxUsesPerSession), m_maxIdle(desc.maxIdlePerKey) {
+    // Without an archive each session builds its core module from scratch,
+    // which is slow but still correct.
+    if (SLANG_FAILED(globalSession->saveCoreModule(SLANG_ARCHIVE_TYPE_RIFF_LZ4,
+                                                   &m_coreModule))) {
+      m_coreModule = nullptr;
+    }
+    for (SlangInt i = 0; i < desc.preloadModuleCount; ++i) {
+      m_preloadModules.emplace_back(desc.preloadModules[i]);
+    }
+  }
+
+  ~SessionPool() {
+    // Sessions still acquired are dropped too; the pool holds the only
+    // reference to their global sessions.
+    for (auto &entry : m_sessions) {
+      destroySession(entry.first, entry.second);
+    }
+    if (m_coreModule) {
+      m_coreModule->release();
+    }
+  }
+
+  SlangResult prewarm(const slang::SessionDesc &desc, uint32_t count,
+                      ISlangBlob **outDiagnostics) {
+    const std::string key = computeKey(desc);
+    slangc_internal::DiagnosticsBuilder diagnostics;
+    SlangResult result = SLANG_OK;
+    for (uint32_t i = 0; i < count; ++i) {
+      slang::ISession *session = nullptr;
+      PooledSession pooled{key};
+      result = createSession(desc, &session, pooled, diagnostics);
+      if (SLANG_FAILED(result)) {
+        break;
+      }
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_sessions[session] = pooled;
+      m_idle[key].push_back(session);
+    }
+    finishDiagnostics(diagnostics, outDiagnostics);
+    return result;
+  }
+
+  SlangResult acquire(const slang::SessionDesc &desc,
+                      slang::ISession **outSession,
+                      ISlangBlob **outDiagnostics) {
+    const std::string key = computeKey(desc);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_idle.find(key);
+      if (it != m_idle.end() && !it->second.empty()) {
+        *outSession = it->second.back();
+        it->second.pop_back();
+        m_sessions[*outSession].acquired = true;
+        if (outDiagnostics) {
+          *outDiagnostics = nullptr;
+        }
+        return SLANG_OK;
+      }
+    }
+
+    slangc_internal::DiagnosticsBuilder diagnostics;
+    slang::ISession *session = nullptr;
+    PooledSession pooled{key};
+    pooled.acquired = true;
+    SlangResult result = createSession(desc, &session, pooled, diagnostics);
+    finishDiagnostics(diagnostics, outDiagnostics);
+    if (SLANG_FAILED(result)) {
+      return result;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_sessions[session] = pooled;
+    }
+    *outSession = session;
+    return SLANG_OK;
+  }
+
+  SlangResult release(slang::ISession *session) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_sessions.find(session);
+    // Releasing an idle session twice would hand it to two callers at once.
+    if (it == m_sessions.end() || !it->second.acquired) {
+      return SLANG_E_INVALID_HANDLE;
+    }
+    PooledSession &pooled = it->second;
+    pooled.acquired = false;
+    ++pooled.uses;
+    auto &idle = m_idle[pooled.key];
+    const bool retire = (m_maxUses != 0 && pooled.uses >= m_maxUses) ||
+                        (m_maxIdle != 0 && idle.size() >= m_maxIdle);
+    if (retire) {
+      destroySession(session, pooled);
+      m_sessions.erase(it);
+    } else {
+      idle.push_back(session);
+    }
+    return SLANG_OK;
+  }
+
+  SlangInt idleCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SlangInt count = 0;
+    for (auto &entry : m_idle) {
+      count += SlangInt(entry.second.size());
+    }
+    return count;
+  }
+
+private:
+  static std::string computeKey(const slang::SessionDesc &desc) {
+    slangc_internal::Sha256 hasher;
+    slangc_internal::hashSessionDesc(hasher, desc);
+    // A different file system resolves imports differently, so sessions are
+    // only shared between callers passing the same instance.
+    hasher.updateValue(uintptr_t(desc.fileSystem));
+    uint8_t digest[slangc_internal::Sha256::kDigestSize];
+    hasher.finish(digest);
+    return std::string(reinterpret_cast<const char *>(digest), sizeof(digest));
+  }
+
+  static void finishDiagnostics(slangc_internal::DiagnosticsBuilder &diagnostics,
+                                ISlangBlob **outDiagnostics) {
+    ISlangBlob *blob = diagnostics.finish();
+    if (outDiagnostics) {
+      *outDiagnostics = blob;
+    } else if (blob) {
+      blob->release();
+    }
+  }
+
+  static void destroySession(slang::ISession *session,
+                             const PooledSession &pooled) {
+    session->release();
+    pooled.globalSession->release();
+  }
+
+  // Runs without the pool lock: nothing else can see the new global session
+  // until it is published in m_sessions.
+  SlangResult createSession(const slang::SessionDesc &desc,
+                            slang::ISession **outSession, PooledSession &pooled,
+                            slangc_internal::DiagnosticsBuilder &diagnostics) {
+    slang::IGlobalSession *globalSession = nullptr;
+    SlangResult result = slangc_internal::createGlobalSessionFromCoreModule(
+        m_coreModule, &globalSession);
+    if (SLANG_FAILED(result)) {
+      return result;
+    }
+    slang::ISession *session = nullptr;
+    result = globalSession->createSession(desc, &session);
+    if (SLANG_FAILED(result)) {
+      globalSession->release();
+      return result;
+    }
+    for (const std::string &name : m_preloadModules) {
+      ISlangBlob *moduleDiagnostics = nullptr;
+      slang::IModule *module =
+          session->loadModule(name.c_str(), &moduleDiagnostics);
+      diagnostics.append(moduleDiagnostics);
+      if (!module) {
+        session->release();
+        globalSession->release();
+        return SLANG_FAIL;
+      }
+    }
+    pooled.globalSession = globalSession;
+    *outSession = session;
+    return SLANG_OK;
+  }
+
+  ISlangBlob *m_coreModule = nullptr;
+  std::vector<std::string> m_preloadModules;
+  uint32_t m_maxUses;
+  uint32_t m_maxIdle;
+
+  std::mutex m_mutex;
+  std::unordered_map<slang::ISession *, PooledSession> m_sessions;
+  std::unordered_map<std::string, std::vector<slang::ISession *>> m_idle;
+};
+} // namespace
+
+extern "C" {
+slangc::SlangResult SessionPool_create(slangc::IGlobalSession inGlobalSession,
+                                       const slangc::SessionPoolDesc *inDesc,
+                                       slangc::SessionPool *outPool) {
+  if (!inGlobalSession || !inDesc || !outPool ||
+      (inDesc->preloadModuleCount > 0 && !inDesc->preloadModules)) {
+    return SLANG_E_INVALID_ARG;
+  }
+  *outPool = new SessionPool((slang::IGlobalSession *)inGlobalSession, *inDesc);
+  return SLANG_OK;
+}
+
+void SessionPool_destroy(slangc::SessionPool pool) {
+  delete (SessionPool *)pool;
+}
+
+slangc::SlangResult SessionPool_prewarm(slangc::SessionPool pool,
+                                        const slangc::SessionDesc *inSessionDesc,
+                                        uint32_t count,
+                                        slangc::IBlob *outDiagnostics) {
+  if (!pool || !inSessionDesc) {
+    return SLANG_E_INVALID_ARG;
+  }
+  const auto &desc = *(const slang::SessionDesc *)inSessionDesc;
+  return ((SessionPool *)pool)
+      ->prewarm(desc, count, (ISlangBlob **)outDiagnostics);
+}
+
+slangc::SlangResult SessionPool_acquire(slangc::SessionPool pool,
+                                        const slangc::SessionDesc *inSessionDesc,
+                                        slangc::ISession *outSession,
+                                        slangc::IBlob *outDiagnostics) {
+  if (!pool || !inSessionDesc || !outSession) {
+    return SLANG_E_INVALID_ARG;
+  }
+  const auto &desc = *(const slang::SessionDesc *)inSessionDesc;
+  return ((SessionPool *)pool)
+      ->acquire(desc, (slang::ISession **)outSession,
+                (ISlangBlob **)outDiagnostics);
+}
+
+slangc::SlangResult SessionPool_release(slangc::SessionPool pool,
+                                        slangc::ISession inSession) {
+  if (!pool || !inSession) {
+    return SLANG_E_INVALID_ARG;
+  }
+  return ((SessionPool *)pool)->release((slang::ISession *)inSession);
+}
+
+SlangInt SessionPool_getIdleCount(slangc::SessionPool pool) {
+  return ((SessionPool *)pool)->idleCount();
+}
+}
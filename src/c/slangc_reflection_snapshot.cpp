@@ -0,0 +1,309 @@
+#include "slang.h"
+#include "slangc_internal.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+namespace slangc {
+#include "slangc.h"
+} // namespace slangc
+
+namespace {
+using slangc::ReflectionSnapshotBindingRange;
+using slangc::ReflectionSnapshotDescriptorRange;
+using slangc::ReflectionSnapshotDescriptorSet;
+using slangc::ReflectionSnapshotEntryPoint;
+using slangc::ReflectionSnapshotHeader;
+using slangc::ReflectionSnapshotSection;
+using slangc::ReflectionSnapshotType;
+using slangc::ReflectionSnapshotVariable;
+
+constexpr uint32_t kNone = SLANGC_REFLECTION_NONE;
+
+size_t alignUp(size_t value) { return (value + 7) & ~size_t(7); }
+
+// Records are appended depth first. Ranges owned by one record (a struct's
+// fields, a type's binding ranges) are reserved before recursing so they stay
+// contiguous, and filled in once their own references are known. Records
+// are built in locals and copied in afterwards, since recursion may grow the
+// vectors.
+class SnapshotBuilder {
+public:
+  explicit SnapshotBuilder(slang::ProgramLayout *layout) {
+    m_strings.push_back('\0');
+    m_stringOffsets.emplace(std::string(), 0);
+
+    m_header.parameterCount = layout->getParameterCount();
+    m_header.parameterFirst = reserve(m_variables, m_header.parameterCount);
+    for (uint32_t i = 0; i < m_header.parameterCount; ++i) {
+      const auto variable = makeVariable(layout->getParameterByIndex(i));
+      m_variables[m_header.parameterFirst + i] = variable;
+    }
+    m_header.globalParamsType = addType(layout->getGlobalParamsTypeLayout());
+    m_header.globalConstantBufferBinding =
+        uint32_t(layout->getGlobalConstantBufferBinding());
+    m_header.globalConstantBufferSize = layout->getGlobalConstantBufferSize();
+
+    const SlangUInt entryPointCount = layout->getEntryPointCount();
+    for (SlangUInt i = 0; i < entryPointCount; ++i) {
+      addEntryPoint(layout->getEntryPointByIndex(i));
+    }
+  }
+
+  // Fills in the section table; returns the total size, or 0 when it does
+  // not fit the format's 32-bit offsets.
+  size_t layoutSections() {
+    size_t offset = alignUp(sizeof(ReflectionSnapshotHeader));
+    bool fits = true;
+    auto place = [&](ReflectionSnapshotSection &section, size_t count,
+                     size_t elementSize) {
+      fits = fits && offset <= UINT32_MAX && count <= UINT32_MAX;
+      section.offset = uint32_t(offset);
+      section.count = uint32_t(count);
+      offset = alignUp(offset + count * elementSize);
+    };
+    place(m_header.types, m_types.size(), sizeof(ReflectionSnapshotType));
+    place(m_header.variables, m_variables.size(),
+          sizeof(ReflectionSnapshotVariable));
+    place(m_header.bindingRanges, m_bindingRanges.size(),
+          sizeof(ReflectionSnapshotBindingRange));
+    place(m_header.descriptorSets, m_descriptorSets.size(),
+          sizeof(ReflectionSnapshotDescriptorSet));
+    place(m_header.descriptorRanges, m_descriptorRanges.size(),
+          sizeof(ReflectionSnapshotDescriptorRange));
+    place(m_header.entryPoints, m_entryPoints.size(),
+          sizeof(ReflectionSnapshotEntryPoint));
+    place(m_header.strings, m_strings.size(), 1);
+    if (!fits || offset > UINT32_MAX) {
+      return 0;
+    }
+    m_header.magic = SLANGC_REFLECTION_SNAPSHOT_MAGIC;
+    m_header.version = SLANGC_REFLECTION_SNAPSHOT_VERSION;
+    m_header.totalSize = offset;
+    return offset;
+  }
+
+  void write(void *buffer) const {
+    auto *bytes = static_cast<uint8_t *>(buffer);
+    std::memset(bytes, 0, size_t(m_header.totalSize));
+    std::memcpy(bytes, &m_header, sizeof(m_header));
+    copySection(bytes, m_header.types, m_types);
+    copySection(bytes, m_header.variables, m_variables);
+    copySection(bytes, m_header.bindingRanges, m_bindingRanges);
+    copySection(bytes, m_header.descriptorSets, m_descriptorSets);
+    copySection(bytes, m_header.descriptorRanges, m_descriptorRanges);
+    copySection(bytes, m_header.entryPoints, m_entryPoints);
+    std::memcpy(bytes + m_header.strings.offset, m_strings.data(),
+                m_strings.size());
+  }
+
+private:
+  template <typename T>
+  static uint32_t reserve(std::vector<T> &records, size_t count) {
+    const uint32_t first = uint32_t(records.size());
+    records.resize(records.size() + count, T{});
+    return first;
+  }
+
+  template <typename T>
+  static void copySection(uint8_t *bytes,
+                          const ReflectionSnapshotSection &section,
+                          const std::vector<T> &records) {
+    if (!records.empty()) {
+      std::memcpy(bytes + section.offset, records.data(),
+                  records.size() * sizeof(T));
+    }
+  }
+
+  uint32_t addString(const char *text) {
+    if (!text || !*text) {
+      return 0;
+    }
+    auto it = m_stringOffsets.find(text);
+    if (it != m_stringOffsets.end()) {
+      return it->second;
+    }
+    const uint32_t offset = uint32_t(m_strings.size());
+    m_strings.insert(m_strings.end(), text, text + std::strlen(text) + 1);
+    m_stringOffsets.emplace(text, offset);
+    return offset;
+  }
+
+  uint32_t addType(slang::TypeLayoutReflection *typeLayout) {
+    if (!typeLayout) {
+      return kNone;
+    }
+    auto it = m_typeIndices.find(typeLayout);
+    if (it != m_typeIndices.end()) {
+      return it->second;
+    }
+    // Registered before recursing so self-referential layouts terminate.
+    const uint32_t index = reserve(m_types, 1);
+    m_typeIndices.emplace(typeLayout, index);
+
+    ReflectionSnapshotType type = {};
+    type.name = addString(typeLayout->getName());
+    type.kind = uint32_t(typeLayout->getKind());
+    type.scalarType = uint32_t(typeLayout->getScalarType());
+    type.parameterCategory = uint32_t(typeLayout->getParameterCategory());
+    type.uniformSize = typeLayout->getSize();
+    type.uniformStride = typeLayout->getStride();
+    type.uniformAlignment = uint32_t(typeLayout->getAlignment());
+    type.rowCount = typeLayout->getRowCount();
+    type.columnCount = typeLayout->getColumnCount();
+    type.resourceShape = uint32_t(typeLayout->getResourceShape());
+    type.resourceAccess = uint32_t(typeLayout->getResourceAccess());
+    type.elementCount = typeLayout->getElementCount();
+    type.elementType = addType(typeLayout->getElementTypeLayout());
+
+    type.fieldCount = typeLayout->getFieldCount();
+    type.fieldFirst = reserve(m_variables, type.fieldCount);
+    for (uint32_t i = 0; i < type.fieldCount; ++i) {
+      const auto variable = makeVariable(typeLayout->getFieldByIndex(i));
+      m_variables[type.fieldFirst + i] = variable;
+    }
+
+    const SlangInt bindingRangeCount = typeLayout->getBindingRangeCount();
+    type.bindingRangeCount = uint32_t(bindingRangeCount);
+    type.bindingRangeFirst = reserve(m_bindingRanges, size_t(bindingRangeCount));
+    for (SlangInt i = 0; i < bindingRangeCount; ++i) {
+      ReflectionSnapshotBindingRange range = {};
+      range.bindingType = uint32_t(typeLayout->getBindingRangeType(i));
+      range.bindingCount = typeLayout->getBindingRangeBindingCount(i);
+      range.descriptorSetIndex =
+          uint32_t(typeLayout->getBindingRangeDescriptorSetIndex(i));
+      range.firstDescriptorRange =
+          uint32_t(typeLayout->getBindingRangeFirstDescriptorRangeIndex(i));
+      range.descriptorRangeCount =
+          uint32_t(typeLayout->getBindingRangeDescriptorRangeCount(i));
+      range.leafType = addType(typeLayout->getBindingRangeLeafTypeLayout(i));
+      m_bindingRanges[type.bindingRangeFirst + i] = range;
+    }
+
+    const SlangInt setCount = typeLayout->getDescriptorSetCount();
+    type.descriptorSetCount = uint32_t(setCount);
+    type.descriptorSetFirst = reserve(m_descriptorSets, size_t(setCount));
+    for (SlangInt set = 0; set < setCount; ++set) {
+      ReflectionSnapshotDescriptorSet descriptorSet = {};
+      descriptorSet.spaceOffset =
+          uint32_t(typeLayout->getDescriptorSetSpaceOffset(set));
+      const SlangInt rangeCount =
+          typeLayout->getDescriptorSetDescriptorRangeCount(set);
+      descriptorSet.descriptorRangeCount = uint32_t(rangeCount);
+      descriptorSet.descriptorRangeFirst = uint32_t(m_descriptorRanges.size());
+      for (SlangInt i = 0; i < rangeCount; ++i) {
+        ReflectionSnapshotDescriptorRange range = {};
+        range.indexOffset = uint32_t(
+            typeLayout->getDescriptorSetDescriptorRangeIndexOffset(set, i));
+        range.descriptorCount =
+            typeLayout->getDescriptorSetDescriptorRangeDescriptorCount(set, i);
+        range.bindingType =
+            uint32_t(typeLayout->getDescriptorSetDescriptorRangeType(set, i));
+        range.category = uint32_t(
+            typeLayout->getDescriptorSetDescriptorRangeCategory(set, i));
+        m_descriptorRanges.push_back(range);
+      }
+      m_descriptorSets[type.descriptorSetFirst + set] = descriptorSet;
+    }
+
+    m_types[index] = type;
+    return index;
+  }
+
+  ReflectionSnapshotVariable
+  makeVariable(slang::VariableLayoutReflection *variableLayout) {
+    ReflectionSnapshotVariable variable = {};
+    variable.type = kNone;
+    if (!variableLayout) {
+      return variable;
+    }
+    variable.name = addString(variableLayout->getName());
+    variable.category = uint32_t(variableLayout->getCategory());
+    variable.bindingIndex = variableLayout->getBindingIndex();
+    variable.bindingSpace = variableLayout->getBindingSpace();
+    variable.semanticName = addString(variableLayout->getSemanticName());
+    variable.semanticIndex = uint32_t(variableLayout->getSemanticIndex());
+    variable.uniformOffset = variableLayout->getOffset();
+    variable.type = addType(variableLayout->getTypeLayout());
+    return variable;
+  }
+
+  void addEntryPoint(slang::EntryPointReflection *entryPoint) {
+    ReflectionSnapshotEntryPoint record = {};
+    record.name = addString(entryPoint->getName());
+    record.stage = uint32_t(entryPoint->getStage());
+    SlangUInt threadGroupSize[3] = {};
+    entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+    for (int axis = 0; axis < 3; ++axis) {
+      record.threadGroupSize[axis] = threadGroupSize[axis];
+    }
+    if (entryPoint->usesAnySampleRateInput()) {
+      record.flags |= SLANGC_ENTRY_POINT_USES_SAMPLE_RATE_INPUT;
+    }
+    if (entryPoint->hasDefaultConstantBuffer()) {
+      record.flags |= SLANGC_ENTRY_POINT_HAS_DEFAULT_CONSTANT_BUFFER;
+    }
+
+    record.parameterCount = entryPoint->getParameterCount();
+    record.parameterFirst = reserve(m_variables, record.parameterCount);
+    for (uint32_t i = 0; i < record.parameterCount; ++i) {
+      const auto variable = makeVariable(entryPoint->getParameterByIndex(i));
+      m_variables[record.parameterFirst + i] = variable;
+    }
+    record.resultVariable = kNone;
+    if (slang::VariableLayoutReflection *result =
+            entryPoint->getResultVarLayout()) {
+      record.resultVariable = reserve(m_variables, 1);
+      const auto variable = makeVariable(result);
+      m_variables[record.resultVariable] = variable;
+    }
+    m_entryPoints.push_back(record);
+  }
+
+  ReflectionSnapshotHeader m_header = {};
+  std::vector<ReflectionSnapshotType> m_types;
+  std::vector<ReflectionSnapshotVariable> m_variables;
+  std::vector<ReflectionSnapshotBindingRange> m_bindingRanges;
+  std::vector<ReflectionSnapshotDescriptorSet> m_descriptorSets;
+  std::vector<ReflectionSnapshotDescriptorRange> m_descriptorRanges;
+  std::vector<ReflectionSnapshotEntryPoint> m_entryPoints;
+  std::vector<char> m_strings;
+  std::unordered_map<std::string, uint32_t> m_stringOffsets;
+  std::unordered_map<slang::TypeLayoutReflection *, uint32_t> m_typeIndices;
+};
+} // namespace
+
+SlangResult slangc_internal::buildReflectionSnapshot(slang::ProgramLayout *layout,
+                                                     std::vector<uint8_t> &out) {
+  SnapshotBuilder builder(layout);
+  const size_t size = builder.layoutSections();
+  if (size == 0) {
+    return SLANG_FAIL;
+  }
+  out.resize(size);
+  builder.write(out.data());
+  return SLANG_OK;
+}
+
+extern "C" {
+slangc::SlangResult writeReflectionSnapshot(slangc::ProgramLayout layout,
+                                            void *buffer, size_t bufferSize,
+                                            size_t *outSize) {
+  if (!layout || !outSize || (bufferSize > 0 && !buffer) ||
+      (reinterpret_cast<uintptr_t>(buffer) & 7) != 0) {
+    return SLANG_E_INVALID_ARG;
+  }
+  SnapshotBuilder builder((slang::ProgramLayout *)layout);
+  const size_t size = builder.layoutSections();
+  if (size == 0) {
+    return SLANG_FAIL;
+  }
+  *outSize = size;
+  if (size > bufferSize) {
+    return SLANG_E_BUFFER_TOO_SMALL;
+  }
+  builder.write(buffer);
+  return SLANG_OK;
+}
+}
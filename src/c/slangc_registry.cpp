@@ -0,0 +1,116 @@
+#include "slang.h"
+#include "slangc_internal.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+namespace slangc {
+#include "slangc.h"
+} // namespace slangc
+
+namespace {
+using slangc_internal::Sha256;
+
+struct RegisteredModule {
+  slang::IModule *module;
+  uint8_t sourceDigest[Sha256::kDigestSize];
+};
+
+class ModuleRegistry {
+public:
+  explicit ModuleRegistry(slang::ISession *session) : m_session(session) {
+    m_session->addRef();
+  }
+
+  ~ModuleRegistry() { m_session->release(); }
+
+  SlangResult load(const char *moduleName, const char *path,
+                   const char *source, slang::IModule **outModule,
+                   ISlangBlob **outDiagnostics) {
+    uint8_t digest[Sha256::kDigestSize];
+    Sha256 hasher;
+    hasher.update(source, std::strlen(source));
+    hasher.finish(digest);
+
+    auto it = m_modules.find(moduleName);
+    if (it != m_modules.end()) {
+      if (std::memcmp(it->second.sourceDigest, digest, sizeof(digest)) != 0) {
+        const std::string message = "module '" + std::string(moduleName) +
+                                    "' is already loaded with different "
+                                    "source\n";
+        *outDiagnostics =
+            slangc_internal::Blob::create(message.c_str(), message.size() + 1);
+        *outModule = nullptr;
+        return SLANG_FAIL;
+      }
+      *outModule = it->second.module;
+      return SLANG_OK;
+    }
+
+    const std::string defaultPath =
+        path ? std::string() : std::string(moduleName) + ".slang";
+    slang::IModule *module = m_session->loadModuleFromSourceString(
+        moduleName, path ? path : defaultPath.c_str(), source, outDiagnostics);
+    *outModule = module;
+    if (!module) {
+      return SLANG_FAIL;
+    }
+    RegisteredModule entry;
+    entry.module = module;
+    std::memcpy(entry.sourceDigest, digest, sizeof(digest));
+    m_modules.emplace(moduleName, entry);
+    return SLANG_OK;
+  }
+
+  slang::IModule *find(const char *moduleName) const {
+    auto it = m_modules.find(moduleName);
+    return it == m_modules.end() ? nullptr : it->second.module;
+  }
+
+  SlangInt count() const { return SlangInt(m_modules.size()); }
+
+private:
+  slang::ISession *m_session;
+  std::unordered_map<std::string, RegisteredModule> m_modules;
+};
+} // namespace
+
+extern "C" {
+slangc::SlangResult ModuleRegistry_create(slangc::ISession inSession,
+                                          slangc::ModuleRegistry *outRegistry) {
+  if (!inSession || !outRegistry) {
+    return SLANG_E_INVALID_ARG;
+  }
+  *outRegistry = new ModuleRegistry((slang::ISession *)inSession);
+  return SLANG_OK;
+}
+
+void ModuleRegistry_destroy(slangc::ModuleRegistry registry) {
+  delete (ModuleRegistry *)registry;
+}
+
+slangc::SlangResult ModuleRegistry_load(slangc::ModuleRegistry registry,
+                                        const char *moduleName,
+                                        const char *path,
+                                        const char *sourceBuffer,
+                                        slangc::IModule *outModule,
+                                        slangc::IBlob *outDiagnostics) {
+  if (!registry || !moduleName || !sourceBuffer || !outModule ||
+      !outDiagnostics) {
+    return SLANG_E_INVALID_ARG;
+  }
+  *outDiagnostics = nullptr;
+  return ((ModuleRegistry *)registry)
+      ->load(moduleName, path, sourceBuffer, (slang::IModule **)outModule,
+             (ISlangBlob **)outDiagnostics);
+}
+
+slangc::IModule ModuleRegistry_find(slangc::ModuleRegistry registry,
+                                    const char *moduleName) {
+  return ((ModuleRegistry *)registry)->find(moduleName);
+}
+
+SlangInt ModuleRegistry_getCount(slangc::ModuleRegistry registry) {
+  return ((ModuleRegistry *)registry)->count();
+}
+}
@@ -0,0 +1,510 @@
+#include "slang.h"
+#include "slangc_internal.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+namespace slangc {
+#include "slangc.h"
+} // namespace slangc
+
+namespace {
+struct Job {
+  std::string source;
+  std::string entryPointName;
+  uint32_t stage;
+  SlangInt targetIndex;
+  slangc::CompileCallback callback = nullptr;
+  void *userData = nullptr;
+
+  // Guarded by Scheduler::m_mutex.
+  bool done = false;
+  // The worker still owns the job while its callback runs; a waiter that
+  // collects it meanwhile sets `collected` and leaves the delete to the
+  // worker.
+  bool inCallback = false;
+  bool collected = false;
+  SlangResult result = SLANG_E_PENDING;
+  ISlangBlob *code = nullptr;
+  ISlangBlob *diagnostics = nullptr;
+};
+
+// Descriptor that becomes readable whenever a job completes: an eventfd on
+// Linux, a non-blocking pipe on other POSIX systems, unavailable on Windows.
+class CompletionSignal {
+public:
+  CompletionSignal() {
+#if defined(__linux__)
+    m_readFd = m_writeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+#elif !defined(_WIN32)
+    int fds[2];
+    if (pipe(fds) == 0) {
+      for (int fd : fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+      }
+      m_readFd = fds[0];
+      m_writeFd = fds[1];
+    }
+#endif
+  }
+
+  ~CompletionSignal() {
+#if !defined(_WIN32)
+    if (m_readFd >= 0) {
+      close(m_readFd);
+    }
+    if (m_writeFd >= 0 && m_writeFd != m_readFd) {
+      close(m_writeFd);
+    }
+#endif
+  }
+
+  CompletionSignal(const CompletionSignal &) = delete;
+  CompletionSignal &operator=(const CompletionSignal &) = delete;
+
+  int fd() const { return m_readFd; }
+
+  void notify() {
+#if defined(__linux__)
+    if (m_writeFd >= 0) {
+      uint64_t one = 1;
+      (void)!write(m_writeFd, &one, sizeof(one));
+    }
+#elif !defined(_WIN32)
+    if (m_writeFd >= 0) {
+      // A full pipe already reads as ready, so a dropped byte is harmless.
+      char byte = 0;
+      (void)!write(m_writeFd, &byte, 1);
+    }
+#endif
+  }
+
+  void drain() {
+#if defined(__linux__)
+    if (m_readFd >= 0) {
+      uint64_t count;
+      (void)!read(m_readFd, &count, sizeof(count));
+    }
+#elif !defined(_WIN32)
+    if (m_readFd >= 0) {
+      char buffer[256];
+      while (read(m_readFd, buffer, sizeof(buffer)) > 0) {
+      }
+    }
+#endif
+  }
+
+private:
+  int m_readFd = -1;
+  int m_writeFd = -1;
+};
+
+struct Worker {
+  std::mutex mutex;
+  std::deque<Job *> queue;
+  std::thread thread;
+  slang::IGlobalSession *globalSession = nullptr;
+  slang::ISession *session = nullptr;
+  uint64_t moduleCounter = 0;
+  // Jobs compiled in `session` since it was created.
+  uint32_t sessionJobs = 0;
+};
+
+// Fixed pool of workers, each with a private Slang session. Jobs are pushed
+// round-robin onto per-worker deques; a worker drains its own deque from the
+// front and steals from the back of the others when it runs dry. Every job
+// leaves its module behind in the worker session, so a worker replaces its
+// session after maxJobsPerSession jobs to bound that growth.
+class Scheduler {
+public:
+  Scheduler(const slang::SessionDesc &desc,
+            const slangc::CompileSchedulerDesc &schedulerDesc,
+            uint32_t threadCount)
+      : m_desc(desc), m_maxJobsPerSession(schedulerDesc.maxJobsPerSession),
+        m_coreModuleCachePath(schedulerDesc.coreModuleCachePath
+                                  ? schedulerDesc.coreModuleCachePath
+                                  : "") {
+    for (uint32_t i = 0; i < threadCount; ++i) {
+      m_workers.push_back(std::make_unique<Worker>());
+    }
+  }
+
+  ~Scheduler() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for (auto &worker : m_workers) {
+      if (worker->thread.joinable()) {
+        worker->thread.join();
+      }
+      if (worker->session) {
+        worker->session->release();
+      }
+      if (worker->globalSession) {
+        worker->globalSession->release();
+      }
+    }
+    for (Job *job : m_jobs) {
+      releaseResults(job);
+      delete job;
+    }
+    if (m_coreModule) {
+      m_coreModule->release();
+    }
+  }
+
+  SlangResult start() {
+    // Build the core module once and hand the first global session to worker
+    // 0; the other workers load the serialized copy instead of rebuilding it.
+    slang::IGlobalSession *seed = nullptr;
+    SlangResult result =
+        m_coreModuleCachePath.empty()
+            ? slang_createGlobalSession(SLANG_API_VERSION, &seed)
+            : slangc::createGlobalSessionWithCoreModuleCache(
+                  m_coreModuleCachePath.c_str(),
+                  (slangc::IGlobalSession *)&seed);
+    if (SLANG_FAILED(result)) {
+      return result;
+    }
+    m_workers[0]->globalSession = seed;
+    if (m_workers.size() > 1 &&
+        SLANG_FAILED(
+            seed->saveCoreModule(SLANG_ARCHIVE_TYPE_RIFF_LZ4, &m_coreModule))) {
+      m_coreModule = nullptr;
+    }
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+      m_workers[i]->thread = std::thread([this, i] { run(i); });
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_initDone.wait(lock, [&] { return m_initialized == m_workers.size(); });
+    return m_initResult;
+  }
+
+  uint32_t threadCount() const { return uint32_t(m_workers.size()); }
+
+  Job *submit(const slangc::CompileRequest &request,
+             slangc::CompileCallback callback, void *userData) {
+    auto *job = new Job();
+    job->source = request.source;
+    job->entryPointName = request.entryPointName;
+    job->stage = request.stage;
+    job->targetIndex = request.targetIndex;
+    job->callback = callback;
+    job->userData = userData;
+
+    Worker &worker = *m_workers[m_nextWorker++ % m_workers.size()];
+    {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.queue.push_back(job);
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_jobs.insert(job);
+      ++m_queued;
+    }
+    m_workAvailable.notify_one();
+    return job;
+  }
+
+  SlangResult wait(Job *job, bool block, slangc::CompileResult &outResult) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (!m_jobs.count(job)) {
+        return SLANG_E_INVALID_HANDLE;
+      }
+      if (!block && !job->done) {
+        return SLANG_E_PENDING;
+      }
+      m_jobDone.wait(lock, [&] { return job->done; });
+      m_jobs.erase(job);
+      outResult.result = job->result;
+      outResult.code = job->code;
+      outResult.diagnostics = job->diagnostics;
+      if (job->inCallback) {
+        job->collected = true;
+        return outResult.result;
+      }
+    }
+    delete job;
+    return outResult.result;
+  }
+
+  int completionFd() const { return m_completionSignal.fd(); }
+
+  void acknowledgeCompletions() { m_completionSignal.drain(); }
+
+private:
+  static void releaseResults(Job *job) {
+    if (job->code) {
+      job->code->release();
+    }
+    if (job->diagnostics) {
+      job->diagnostics->release();
+    }
+  }
+
+  // Swaps the worker's session for a fresh one, dropping the modules of the
+  // jobs it compiled. On failure the old session stays in use.
+  void retireSession(Worker &worker) {
+    slang::ISession *session = nullptr;
+    if (SLANG_FAILED(
+            worker.globalSession->createSession(m_desc.get(), &session))) {
+      return;
+    }
+    worker.session->release();
+    worker.session = session;
+    worker.sessionJobs = 0;
+  }
+
+  void run(size_t index) {
+    Worker &worker = *m_workers[index];
+    SlangResult result =
+        worker.globalSession
+            ? SLANG_OK
+            : slangc_internal::createGlobalSessionFromCoreModule(
+                  m_coreModule, &worker.globalSession);
+    if (SLANG_SUCCEEDED(result)) {
+      result =
+          worker.globalSession->createSession(m_desc.get(), &worker.session);
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (SLANG_FAILED(result) && SLANG_SUCCEEDED(m_initResult)) {
+        m_initResult = result;
+      }
+      ++m_initialized;
+    }
+    m_initDone.notify_all();
+    if (SLANG_FAILED(result)) {
+      return;
+    }
+
+    for (;;) {
+      {
+        // Claim one queued job before looking for it, so every claim is
+        // backed by a job sitting in some deque.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_workAvailable.wait(lock, [&] { return m_stopping || m_queued > 0; });
+        if (m_stopping) {
+          return;
+        }
+        --m_queued;
+      }
+
+      Job *job = nullptr;
+      while (!job) {
+        job = take(index);
+      }
+
+      if (m_maxJobsPerSession != 0 &&
+          worker.sessionJobs >= m_maxJobsPerSession) {
+        retireSession(worker);
+      }
+      ++worker.sessionJobs;
+      const std::string moduleName = "scheduler_module_" +
+                                     std::to_string(index) + "_" +
+                                     std::to_string(worker.moduleCounter++);
+      ISlangBlob *code = nullptr;
+      ISlangBlob *diagnostics = nullptr;
+      SlangResult jobResult = slangc_internal::compileEntryPoint(
+          worker.session, moduleName.c_str(), job->source.c_str(),
+          job->entryPointName.c_str(), job->stage, job->targetIndex, &code,
+          &diagnostics);
+
+      const slangc::CompileCallback callback = job->callback;
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        job->result = jobResult;
+        job->code = code;
+        job->diagnostics = diagnostics;
+        job->done = true;
+        job->inCallback = callback != nullptr;
+      }
+      m_jobDone.notify_all();
+      m_completionSignal.notify();
+      if (callback) {
+        callback(job, jobResult, job->userData);
+        bool collected;
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          job->inCallback = false;
+          collected = job->collected;
+        }
+        if (collected) {
+          delete job;
+        }
+      }
+    }
+  }
+
+  Job *take(size_t index) {
+    {
+      Worker &own = *m_workers[index];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.queue.empty()) {
+        Job *job = own.queue.front();
+        own.queue.pop_front();
+        return job;
+      }
+    }
+    for (size_t offset = 1; offset < m_workers.size(); ++offset) {
+      Worker &victim = *m_workers[(index + offset) % m_workers.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.queue.empty()) {
+        Job *job = victim.queue.back();
+        victim.queue.pop_back();
+        return job;
+      }
+    }
+    return nullptr;
+  }
+
+  slangc_internal::SessionDescStorage m_desc;
+  const uint32_t m_maxJobsPerSession;
+  const std::string m_coreModuleCachePath;
+  // Serialized core module shared by the worker global sessions.
+  ISlangBlob *m_coreModule = nullptr;
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::atomic<size_t> m_nextWorker{0};
+
+  std::mutex m_mutex;
+  std::condition_variable m_workAvailable;
+  std::condition_variable m_jobDone;
+  std::condition_variable m_initDone;
+  std::unordered_set<Job *> m_jobs;
+  size_t m_queued = 0;
+  size_t m_initialized = 0;
+  SlangResult m_initResult = SLANG_OK;
+  bool m_stopping = false;
+
+  CompletionSignal m_completionSignal;
+};
+} // namespace
+
+extern "C" {
+slangc::SlangResult
+CompileScheduler_create(const slangc::SessionDesc *inSessionDesc,
+                        const slangc::CompileSchedulerDesc *inDesc,
+                        slangc::CompileScheduler *outScheduler) {
+  if (!inSessionDesc || !inDesc || !outScheduler) {
+    return SLANG_E_INVALID_ARG;
+  }
+  uint32_t threadCount = inDesc->threadCount;
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  const auto &sessionDesc = *(const slang::SessionDesc *)inSessionDesc;
+  auto *scheduler = new Scheduler(sessionDesc, *inDesc, threadCount);
+  SlangResult result = scheduler->start();
+  if (SLANG_FAILED(result)) {
+    delete scheduler;
+    *outScheduler = nullptr;
+    return result;
+  }
+  *outScheduler = scheduler;
+  return SLANG_OK;
+}
+
+void CompileScheduler_destroy(slangc::CompileScheduler scheduler) {
+  delete (Scheduler *)scheduler;
+}
+
+uint32_t CompileScheduler_getThreadCount(slangc::CompileScheduler scheduler) {
+  return ((Scheduler *)scheduler)->threadCount();
+}
+
+slangc::SlangResult
+CompileScheduler_submit(slangc::CompileScheduler scheduler,
+                        const slangc::CompileRequest *inRequest,
+                        slangc::CompileJob *outJob) {
+  auto *self = (Scheduler *)scheduler;
+  if (!self || !inRequest || !inRequest->source ||
+      !inRequest->entryPointName || !outJob) {
+    return SLANG_E_INVALID_ARG;
+  }
+  *outJob = self->submit(*inRequest, nullptr, nullptr);
+  return SLANG_OK;
+}
+
+slangc::SlangResult
+CompileScheduler_submitAsync(slangc::CompileScheduler scheduler,
+                             const slangc::CompileRequest *inRequest,
+                             slangc::CompileCallback callback, void *userData,
+                             slangc::CompileJob *outJob) {
+  auto *self = (Scheduler *)scheduler;
+  if (!self || !inRequest || !inRequest->source ||
+      !inRequest->entryPointName || !outJob) {
+    return SLANG_E_INVALID_ARG;
+  }
+  *outJob = self->submit(*inRequest, callback, userData);
+  return SLANG_OK;
+}
+
+slangc::SlangResult CompileScheduler_wait(slangc::CompileScheduler scheduler,
+                                          slangc::CompileJob job,
+                                          slangc::CompileResult *outResult) {
+  auto *self = (Scheduler *)scheduler;
+  if (!self || !job || !outResult) {
+    return SLANG_E_INVALID_ARG;
+  }
+  return self->wait((Job *)job, true, *outResult);
+}
+
+slangc::SlangResult CompileScheduler_tryWait(slangc::CompileScheduler scheduler,
+                                             slangc::CompileJob job,
+                                             slangc::CompileResult *outResult) {
+  auto *self = (Scheduler *)scheduler;
+  if (!self || !job || !outResult) {
+    return SLANG_E_INVALID_ARG;
+  }
+  return self->wait((Job *)job, false, *outResult);
+}
+
+int CompileScheduler_getCompletionFd(slangc::CompileScheduler scheduler) {
+  return ((Scheduler *)scheduler)->completionFd();
+}
+
+void CompileScheduler_acknowledgeCompletions(
+    slangc::CompileScheduler scheduler) {
+  ((Scheduler *)scheduler)->acknowledgeCompletions();
+}
+
+slangc::SlangResult CompileScheduler_waitAll(slangc::CompileScheduler scheduler,
+                                             const slangc::CompileJob *jobs,
+                                             SlangInt jobCount,
+                                             slangc::CompileResult *outResults) {
+  auto *self = (Scheduler *)scheduler;
+  if (!self || (jobCount > 0 && (!jobs || !outResults))) {
+    return SLANG_E_INVALID_ARG;
+  }
+  SlangResult batchResult = SLANG_OK;
+  for (SlangInt i = 0; i < jobCount; ++i) {
+    SlangResult result = jobs[i] ? self->wait((Job *)jobs[i], true, outResults[i])
+                                 : SLANG_E_INVALID_ARG;
+    if (SLANG_FAILED(result) && SLANG_SUCCEEDED(batchResult)) {
+      batchResult = result;
+    }
+  }
+  return batchResult;
+}
+}
@@ -0,0 +1,255 @@
+#include "slang.h"
+#include "slangc_internal.h"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+namespace slangc {
+#include "slangc.h"
+} // namespace slangc
+
+namespace {
+enum class Kind : uint64_t { Type, Generic, Function };
+
+// (kind, specialized declaration, argument words...). Generic arguments
+// contribute their tag and value so `int 1` and `bool true` stay distinct.
+using Key = std::vector<uint64_t>;
+
+struct KeyHash {
+  size_t operator()(const Key &key) const {
+    uint64_t hash = 14695981039346656037ull;
+    for (uint64_t word : key) {
+      hash = (hash ^ word) * 1099511628211ull;
+    }
+    return size_t(hash);
+  }
+};
+
+class SpecializationCache {
+public:
+  explicit SpecializationCache(slang::ProgramLayout *layout)
+      : m_layout(layout) {}
+
+  slang::TypeReflection *specializeType(slang::TypeReflection *type,
+                                        SlangInt argCount,
+                                        slang::TypeReflection *const *args,
+                                        ISlangBlob **outDiagnostics) {
+    Key key = makeKey(Kind::Type, type);
+    for (SlangInt i = 0; i < argCount; ++i) {
+      key.push_back(uintptr_t(args[i]));
+    }
+    return lookupOrInsert<slang::TypeReflection>(
+        key, outDiagnostics, [&](ISlangBlob **diagnostics) {
+          return m_layout->specializeType(type, argCount, args, diagnostics);
+        });
+  }
+
+  slang::GenericReflection *
+  specializeGeneric(slang::GenericReflection *generic, SlangInt argCount,
+                    const slang::GenericArgType *argTypes,
+                    const slang::GenericArgReflection *argVals,
+                    ISlangBlob **outDiagnostics) {
+    Key key = makeKey(Kind::Generic, generic);
+    for (SlangInt i = 0; i < argCount; ++i) {
+      key.push_back(uint64_t(argTypes[i]));
+      switch (argTypes[i]) {
+      case slang::SLANG_GENERIC_ARG_TYPE:
+        key.push_back(uintptr_t(argVals[i].typeVal));
+        break;
+      case slang::SLANG_GENERIC_ARG_INT:
+        key.push_back(uint64_t(argVals[i].intVal));
+        break;
+      case slang::SLANG_GENERIC_ARG_BOOL:
+        key.push_back(argVals[i].boolVal ? 1 : 0);
+        break;
+      }
+    }
+    return lookupOrInsert<slang::GenericReflection>(
+        key, outDiagnostics, [&](ISlangBlob **diagnostics) {
+          return m_layout->specializeGeneric(generic, argCount, argTypes,
+                                             argVals, diagnostics);
+        });
+  }
+
+  slang::FunctionReflection *
+  specializeFunction(slang::FunctionReflection *function, unsigned argCount,
+                     slang::TypeReflection *const *argTypes) {
+    Key key = makeKey(Kind::Function, function);
+    for (unsigned i = 0; i < argCount; ++i) {
+      key.push_back(uintptr_t(argTypes[i]));
+    }
+    return lookupOrInsert<slang::FunctionReflection>(
+        key, nullptr, [&](ISlangBlob **) {
+          return function->specializeWithArgTypes(argCount, argTypes);
+        });
+  }
+
+  SlangInt entryCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return SlangInt(m_entries.size());
+  }
+
+private:
+  static Key makeKey(Kind kind, const void *declaration) {
+    return Key{uint64_t(kind), uintptr_t(declaration)};
+  }
+
+  // Slang's reflection objects are not safe to specialize concurrently, so
+  // misses are resolved under the same lock as lookups.
+  template <typename T, typename Specialize>
+  T *lookupOrInsert(const Key &key, ISlangBlob **outDiagnostics,
+                    Specialize &&specialize) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+      if (outDiagnostics) {
+        *outDiagnostics = nullptr;
+      }
+      return static_cast<T *>(it->second);
+    }
+    T *result = specialize(outDiagnostics);
+    if (result) {
+      m_entries.emplace(key, result);
+    }
+    return result;
+  }
+
+  slang::ProgramLayout *m_layout;
+  std::mutex m_mutex;
+  std::unordered_map<Key, void *, KeyHash> m_entries;
+};
+
+// Runs `specializeOne(set, diagnostics)` for each set and gathers the
+// diagnostics of all of them into one blob.
+template <typename Out, typename SpecializeOne>
+SlangResult specializeSets(SlangInt setCount, Out *outResults,
+                           slangc::IBlob *outDiagnostics,
+                           SpecializeOne &&specializeOne) {
+  slangc_internal::DiagnosticsBuilder diagnostics;
+  SlangResult result = SLANG_OK;
+  for (SlangInt set = 0; set < setCount; ++set) {
+    ISlangBlob *setDiagnostics = nullptr;
+    outResults[set] = specializeOne(set, &setDiagnostics);
+    diagnostics.append(setDiagnostics);
+    if (!outResults[set]) {
+      result = SLANG_FAIL;
+    }
+  }
+  ISlangBlob *blob = diagnostics.finish();
+  if (outDiagnostics) {
+    *outDiagnostics = blob;
+  } else if (blob) {
+    blob->release();
+  }
+  return result;
+}
+} // namespace
+
+extern "C" {
+slangc::SlangResult SpecializationCache_create(slangc::ProgramLayout layout,
+                                               slangc::SpecializationCache *outCache) {
+  if (!layout || !outCache) {
+    return SLANG_E_INVALID_ARG;
+  }
+  *outCache = new SpecializationCache((slang::ProgramLayout *)layout);
+  return SLANG_OK;
+}
+
+void SpecializationCache_destroy(slangc::SpecializationCache cache) {
+  delete (SpecializationCache *)cache;
+}
+
+slangc::TypeReflectionPtr SpecializationCache_specializeType(
+    slangc::SpecializationCache cache, slangc::TypeReflectionPtr inType,
+    SlangInt argCount, slangc::TypeReflectionPtr const *args,
+    slangc::IBlob *outDiagnostics) {
+  auto *self = (SpecializationCache *)cache;
+  return self->specializeType((slang::TypeReflection *)inType, argCount,
+                              (slang::TypeReflection *const *)args,
+                              (ISlangBlob **)outDiagnostics);
+}
+
+slangc::GenericReflectionPtr SpecializationCache_specializeGeneric(
+    slangc::SpecializationCache cache, slangc::GenericReflectionPtr inGeneric,
+    SlangInt argCount, slangc::GenericArgType const *argTypes,
+    slangc::GenericArgReflectionPtr const *argVals,
+    slangc::IBlob *outDiagnostics) {
+  auto *self = (SpecializationCache *)cache;
+  return self->specializeGeneric(
+      (slang::GenericReflection *)inGeneric, argCount,
+      (const slang::GenericArgType *)argTypes,
+      (const slang::GenericArgReflection *)argVals,
+      (ISlangBlob **)outDiagnostics);
+}
+
+slangc::FunctionReflectionPtr SpecializationCache_specializeFunction(
+    slangc::SpecializationCache cache, slangc::FunctionReflectionPtr inFunction,
+    unsigned int argCount, slangc::TypeReflectionPtr const *argTypes) {
+  auto *self = (SpecializationCache *)cache;
+  return (slangc::FunctionReflectionPtr)self->specializeFunction(
+      (slang::FunctionReflection *)inFunction, argCount,
+      (slang::TypeReflection *const *)argTypes);
+}
+
+slangc::SlangResult SpecializationCache_specializeTypes(
+    slangc::SpecializationCache cache, slangc::TypeReflectionPtr inType,
+    SlangInt setCount, SlangInt argCount, slangc::TypeReflectionPtr const *args,
+    slangc::TypeReflectionPtr *outTypes, slangc::IBlob *outDiagnostics) {
+  auto *self = (SpecializationCache *)cache;
+  if (!self || setCount < 0 || argCount < 0 ||
+      (setCount > 0 && (!outTypes || (argCount > 0 && !args)))) {
+    return SLANG_E_INVALID_ARG;
+  }
+  return specializeSets(
+      setCount, outTypes, outDiagnostics,
+      [&](SlangInt set, ISlangBlob **diagnostics) {
+        return (slangc::TypeReflectionPtr)self->specializeType(
+            (slang::TypeReflection *)inType, argCount,
+            (slang::TypeReflection *const *)args + set * argCount, diagnostics);
+      });
+}
+
+slangc::SlangResult SpecializationCache_specializeGenerics(
+    slangc::SpecializationCache cache, slangc::GenericReflectionPtr inGeneric,
+    SlangInt setCount, SlangInt argCount, slangc::GenericArgType const *argTypes,
+    slangc::GenericArgReflectionPtr const *argVals,
+    slangc::GenericReflectionPtr *outGenerics, slangc::IBlob *outDiagnostics) {
+  auto *self = (SpecializationCache *)cache;
+  if (!self || setCount < 0 || argCount < 0 ||
+      (setCount > 0 && (!outGenerics || (argCount > 0 && (!argTypes || !argVals))))) {
+    return SLANG_E_INVALID_ARG;
+  }
+  return specializeSets(
+      setCount, outGenerics, outDiagnostics,
+      [&](SlangInt set, ISlangBlob **diagnostics) {
+        return (slangc::GenericReflectionPtr)self->specializeGeneric(
+            (slang::GenericReflection *)inGeneric, argCount,
+            (const slang::GenericArgType *)argTypes + set * argCount,
+            (const slang::GenericArgReflection *)argVals + set * argCount,
+            diagnostics);
+      });
+}
+
+slangc::SlangResult SpecializationCache_specializeFunctions(
+    slangc::SpecializationCache cache, slangc::FunctionReflectionPtr inFunction,
+    SlangInt setCount, unsigned int argCount,
+    slangc::TypeReflectionPtr const *argTypes,
+    slangc::FunctionReflectionPtr *outFunctions) {
+  auto *self = (SpecializationCache *)cache;
+  if (!self || setCount < 0 ||
+      (setCount > 0 && (!outFunctions || (argCount > 0 && !argTypes)))) {
+    return SLANG_E_INVALID_ARG;
+  }
+  return specializeSets(
+      setCount, outFunctions, nullptr,
+      [&](SlangInt set, ISlangBlob **) {
+        return (slangc::FunctionReflectionPtr)self->specializeFunction(
+            (slang::FunctionReflection *)inFunction, argCount,
+            (slang::TypeReflection *const *)argTypes + set * argCount);
+      });
+}
+
+SlangInt SpecializationCache_getEntryCount(slangc::SpecializationCache cache) {
+  return ((SpecializationCache *)cache)->entryCount();
+}
+}
@@ -0,0 +1,179 @@
+#include "slang.h"
+#include "slangc_internal.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+namespace slangc {
+#include "slangc.h"
+} // namespace slangc
+
+namespace {
+// Measures one phase on the wall clock and through the global session's
+// cumulative compiler/downstream counters.
+class PhaseTimer {
+public:
+  explicit PhaseTimer(slang::IGlobalSession *globalSession)
+      : m_globalSession(globalSession),
+        m_start(std::chrono::steady_clock::now()) {
+    if (m_globalSession) {
+      m_globalSession->getCompilerElapsedTime(&m_compilerStart,
+                                              &m_downstreamStart);
+    }
+  }
+
+  void finish(slangc::PhaseTiming *outTiming) const {
+    if (!outTiming) {
+      return;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - m_start;
+    outTiming->wallSeconds = std::chrono::duration<double>(elapsed).count();
+    outTiming->compilerSeconds = 0;
+    outTiming->downstreamSeconds = 0;
+    if (m_globalSession) {
+      double compiler = 0;
+      double downstream = 0;
+      m_globalSession->getCompilerElapsedTime(&compiler, &downstream);
+      outTiming->compilerSeconds = compiler - m_compilerStart;
+      outTiming->downstreamSeconds = downstream - m_downstreamStart;
+    }
+  }
+
+private:
+  slang::IGlobalSession *m_globalSession;
+  std::chrono::steady_clock::time_point m_start;
+  double m_compilerStart = 0;
+  double m_downstreamStart = 0;
+};
+
+slang::IGlobalSession *globalSessionOf(slang::ISession *session) {
+  return session ? session->getGlobalSession() : nullptr;
+}
+
+slang::IGlobalSession *globalSessionOf(slang::IComponentType *component) {
+  return globalSessionOf(component->getSession());
+}
+
+const char *skipSpaces(const char *cursor, const char *end) {
+  while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+    ++cursor;
+  }
+  return cursor;
+}
+
+// Parses one "[*] name <tab> count <tab> 12.34ms" line of the report printed
+// by ReportPerfBenchmark.
+bool parseBenchmarkLine(const char *line, const char *end,
+                        slangc::PerfBenchmarkEntry &outEntry) {
+  const char *marker = std::strstr(line, "[*]");
+  if (!marker || marker >= end) {
+    return false;
+  }
+  const char *cursor = skipSpaces(marker + 3, end);
+  const char *nameBegin = cursor;
+  while (cursor < end && *cursor != ' ' && *cursor != '\t') {
+    ++cursor;
+  }
+  const size_t nameLength = size_t(cursor - nameBegin);
+  if (nameLength == 0) {
+    return false;
+  }
+
+  const std::string rest(skipSpaces(cursor, end), end);
+  char *parseEnd = nullptr;
+  const unsigned long count = std::strtoul(rest.c_str(), &parseEnd, 10);
+  if (parseEnd == rest.c_str()) {
+    return false;
+  }
+  const char *timeBegin = parseEnd;
+  const double milliseconds = std::strtod(timeBegin, &parseEnd);
+  if (parseEnd == timeBegin) {
+    return false;
+  }
+
+  const size_t copied = nameLength < sizeof(outEntry.name) - 1
+                            ? nameLength
+                            : sizeof(outEntry.name) - 1;
+  std::memcpy(outEntry.name, nameBegin, copied);
+  outEntry.name[copied] = '\0';
+  outEntry.invocationCount = uint32_t(count);
+  outEntry.milliseconds = milliseconds;
+  return true;
+}
+} // namespace
+
+extern "C" {
+slangc::SlangResult loadNamedModuleFromSourceStringTimed(
+    slangc::ISession inSession, const char *moduleName, const char *path,
+    const char *sourceBuffer, slangc::IModule *outModule,
+    slangc::IBlob *outDiagnostics, slangc::PhaseTiming *outTiming) {
+  auto *session = (slang::ISession *)inSession;
+  auto **diagnostics = (slang::IBlob **)outDiagnostics;
+  auto **module = (slang::IModule **)outModule;
+
+  PhaseTimer timer(globalSessionOf(session));
+  *module = session->loadModuleFromSourceString(moduleName, path, sourceBuffer,
+                                                diagnostics);
+  timer.finish(outTiming);
+  return *module ? SLANG_OK : SLANG_FAIL;
+}
+
+slangc::SlangResult linkProgramTimed(slangc::IComponentType inCompiledProgram,
+                                     slangc::IComponentType *outLinkedProgram,
+                                     slangc::IBlob *outDiagnostics,
+                                     slangc::PhaseTiming *outTiming) {
+  auto *program = (slang::IComponentType *)inCompiledProgram;
+  auto **linkedProgram = (slang::IComponentType **)outLinkedProgram;
+  auto **diagnostics = (slang::IBlob **)outDiagnostics;
+
+  PhaseTimer timer(globalSessionOf(program));
+  SlangResult result = program->link(linkedProgram, diagnostics);
+  timer.finish(outTiming);
+  return result;
+}
+
+slangc::SlangResult getTargetCodeTimed(slangc::IComponentType linkedProgram,
+                                       SlangInt targetIndex,
+                                       slangc::IBlob *outOutput,
+                                       slangc::IBlob *outDiagnostics,
+                                       slangc::PhaseTiming *outTiming) {
+  auto *program = (slang::IComponentType *)linkedProgram;
+  auto **output = (slang::IBlob **)outOutput;
+  auto **diagnostics = (slang::IBlob **)outDiagnostics;
+
+  PhaseTimer timer(globalSessionOf(program));
+  SlangResult result = program->getTargetCode(targetIndex, output, diagnostics);
+  timer.finish(outTiming);
+  return result;
+}
+
+slangc::SlangResult parsePerfBenchmark(const char *text, size_t size,
+                                       slangc::PerfBenchmarkEntry *outEntries,
+                                       SlangInt capacity, SlangInt *outCount) {
+  if ((size > 0 && !text) || (capacity > 0 && !outEntries) || !outCount) {
+    return SLANG_E_INVALID_ARG;
+  }
+  SlangInt count = 0;
+  const char *end = text + size;
+  for (const char *line = text; line < end;) {
+    const char *lineEnd = static_cast<const char *>(
+        std::memchr(line, '\n', size_t(end - line)));
+    if (!lineEnd) {
+      lineEnd = end;
+    }
+    const std::string lineText(line, lineEnd);
+    slangc::PerfBenchmarkEntry entry;
+    if (parseBenchmarkLine(lineText.c_str(),
+                           lineText.c_str() + lineText.size(), entry)) {
+      if (count < capacity) {
+        outEntries[count] = entry;
+      }
+      ++count;
+    }
+    line = lineEnd + 1;
+  }
+  *outCount = count;
+  return count > capacity ? SLANG_E_BUFFER_TOO_SMALL : SLANG_OK;
+}
+}
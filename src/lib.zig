@@ -14,9 +14,23 @@ pub const TypeParameterReflection = @import("./reflection/TypeParameterReflectio
 pub const FunctionReflection = @import("./reflection/FunctionReflection.zig");
 pub const EntryPointReflection = @import("./reflection/EntryPointReflection.zig");
 pub const AttributeReflection = @import("./reflection/AttributeReflection.zig");
+pub const ReflectionSnapshot = @import("./reflection/Snapshot.zig");
+pub const DescriptorSetLayouts = @import("./reflection/DescriptorSetLayouts.zig");
+pub const UniformCodegen = @import("./reflection/UniformCodegen.zig");
+pub const LazyProgram = @import("./LazyProgram.zig");
+pub const VariantSet = @import("./VariantSet.zig");
+pub const HotReload = @import("./HotReload.zig");
+pub const StringTable = @import("./StringTable.zig");
+pub const ReflectionBuilder = @import("./ReflectionBuilder.zig");
+pub const ParameterUsage = @import("./ParameterUsage.zig");
 
 pub var gs = std.mem.zeroes(c.IGlobalSession);
 
+/// Process-wide table for reflection names. Names stay valid until `deinit`
+/// or `names.reset()`; a long-running process that rebuilds reflection, e.g.
+/// on every hot reload, can reset it once the old structures are gone.
+pub var names: StringTable = .init(std.heap.smp_allocator);
+
 pub const IGlobalSession = c.IGlobalSession;
 pub const ISession = c.ISession;
 pub const IModule = c.IModule;
@@ -38,6 +52,16 @@ pub const DeclReflectionPtr = c.DeclReflectionPtr;
 pub const Modifier = c.Modifier;
 pub const AttributeReflectionPtr = c.Attribute;
 pub const Unknown = c.Unknown;
+pub const ReleaseDataCallback = c.ReleaseDataCallback;
+pub const MemoryFileSystem = c.MemoryFileSystem;
+pub const ModuleRegistry = c.ModuleRegistry;
+pub const CompileScheduler = c.CompileScheduler;
+pub const CompileJob = c.CompileJob;
+pub const CompileCallback = c.CompileCallback;
+pub const SessionPool = c.SessionPool;
+pub const CompileCache = c.CompileCache;
+pub const CompileCacheKey = c.CompileCacheKey;
+pub const SpecializationCache = c.SpecializationCache;
 
 pub const GenericArgReflection = c.GenericArgReflection;
 
@@ -276,6 +300,22 @@ pub const CompilerOptionEntry = extern struct {
     }
 };
 
+pub const CompileRequest = c.CompileRequest;
+
+/// A request for `entryPointName` in `source`, compiled for target 0.
+pub fn compileRequest(source: [:0]const u8, entryPointName: [:0]const u8, stage: Stage) CompileRequest {
+    return .{
+        .source = source.ptr,
+        .entryPointName = entryPointName.ptr,
+        .stage = @intFromEnum(stage),
+        .targetIndex = 0,
+    };
+}
+
+pub const CompileResult = c.CompileResult;
+pub const PhaseTiming = c.PhaseTiming;
+pub const PerfBenchmarkEntry = c.PerfBenchmarkEntry;
+
 pub const CompileTarget = enum(i32) {
     TARGET_UNKNOWN,
     TARGET_NONE,
@@ -774,6 +814,10 @@ pub fn createGlobalSession(globalSession: *c.IGlobalSession) SlangResult {
     return @enumFromInt(c.createGlobalSession(globalSession));
 }
 
+pub fn createGlobalSessionWithCoreModuleCache(cachePath: [:0]const u8, globalSession: *c.IGlobalSession) SlangResult {
+    return @enumFromInt(c.createGlobalSessionWithCoreModuleCache(cachePath.ptr, globalSession));
+}
+
 pub fn createSession(globalSession: c.IGlobalSession, sessionDesc: *const c.SessionDesc, session: *c.ISession) SlangResult {
     return @enumFromInt(c.createSession(globalSession, sessionDesc, session));
 }
@@ -782,6 +826,44 @@ pub fn loadModuleFromSourceString(ss: c.ISession, sourceBuffer: []const u8, outM
     return @enumFromInt(c.loadModuleFromSourceString(ss, sourceBuffer.ptr, outModule, outDiagnostics));
 }
 
+/// `ReleaseDataCallback` that unmaps memory obtained from `mapFile`.
+pub fn unmapFile(data: ?*const anyopaque, size: usize, _: ?*anyopaque) callconv(.c) void {
+    const ptr: [*]align(std.heap.page_size_min) const u8 = @ptrCast(@alignCast(data.?));
+    std.posix.munmap(ptr[0..size]);
+}
+
+pub fn mapFile(file: std.fs.File, size: usize) ![]align(std.heap.page_size_min) const u8 {
+    return std.posix.mmap(null, size, std.posix.PROT.READ, .{ .TYPE = .PRIVATE }, file.handle, 0);
+}
+
+pub fn loadModuleFromSource(ss: c.ISession, moduleName: [:0]const u8, path: [:0]const u8, source: []const u8, releaseData: ReleaseDataCallback, userData: ?*anyopaque, outModule: *c.IModule, outDiagnostics: *c.IBlob) SlangResult {
+    return @enumFromInt(c.loadModuleFromSource(ss, moduleName.ptr, path.ptr, source.ptr, source.len, releaseData, userData, outModule, outDiagnostics));
+}
+
+/// Maps `file` and loads it as module source without copying; the mapping
+/// lives as long as Slang holds on to the module.
+pub fn loadModuleFromMappedFile(ss: c.ISession, moduleName: [:0]const u8, path: [:0]const u8, file: std.fs.File, outModule: *c.IModule, outDiagnostics: *c.IBlob) !SlangResult {
+    const size: usize = @intCast((try file.stat()).size);
+    if (size == 0) return loadModuleFromSource(ss, moduleName, path, "", null, null, outModule, outDiagnostics);
+    return loadModuleFromSource(ss, moduleName, path, try mapFile(file, size), unmapFile, null, outModule, outDiagnostics);
+}
+
+pub fn loadModuleFromIRBlob(ss: c.ISession, moduleName: [:0]const u8, path: [:0]const u8, data: []const u8, outModule: *c.IModule, outDiagnostics: *c.IBlob) SlangResult {
+    return @enumFromInt(c.loadModuleFromIRBlob(ss, moduleName.ptr, path.ptr, data.ptr, data.len, outModule, outDiagnostics));
+}
+
+pub fn isBinaryModuleUpToDate(ss: c.ISession, modulePath: [:0]const u8, data: []const u8) bool {
+    return c.isBinaryModuleUpToDate(ss, modulePath.ptr, data.ptr, data.len);
+}
+
+pub fn loadModuleWithBinaryCache(ss: c.ISession, cacheDirectory: [:0]const u8, moduleName: [:0]const u8, outModule: *c.IModule, outDiagnostics: *c.IBlob) SlangResult {
+    return @enumFromInt(c.loadModuleWithBinaryCache(ss, cacheDirectory.ptr, moduleName.ptr, outModule, outDiagnostics));
+}
+
+pub fn loadNamedModuleFromSourceString(ss: c.ISession, moduleName: [:0]const u8, path: [:0]const u8, sourceBuffer: [:0]const u8, outModule: *c.IModule, outDiagnostics: *c.IBlob) SlangResult {
+    return @enumFromInt(c.loadNamedModuleFromSourceString(ss, moduleName.ptr, path.ptr, sourceBuffer.ptr, outModule, outDiagnostics));
+}
+
 pub fn findProfile(global: c.IGlobalSession, profile: []const u8) c.SlangProfileID {
     return c.findProfile(global, profile.ptr);
 }
@@ -802,6 +884,78 @@ pub fn getTargetCode(linkedProgram: c.IComponentType, outOutput: *c.IBlob, outDi
     return @enumFromInt(c.getTargetCode(linkedProgram, outOutput, outDiagnostics));
 }
 
+pub fn getTargetCodeByIndex(linkedProgram: c.IComponentType, targetIndex: c.SlangInt, outOutput: *c.IBlob, outDiagnostics: *c.IBlob) SlangResult {
+    return @enumFromInt(c.getTargetCodeByIndex(linkedProgram, targetIndex, outOutput, outDiagnostics));
+}
+
+pub fn getEntryPointCode(linkedProgram: c.IComponentType, entryPointIndex: c.SlangInt, targetIndex: c.SlangInt, outCode: *c.IBlob, outDiagnostics: *c.IBlob) SlangResult {
+    return @enumFromInt(c.getEntryPointCode(linkedProgram, entryPointIndex, targetIndex, outCode, outDiagnostics));
+}
+
+pub fn getAllTargetCode(linkedProgram: c.IComponentType, outOutputs: []c.IBlob, outResults: ?[]c.SlangResult, outDiagnostics: *c.IBlob) SlangResult {
+    if (outResults) |results| assert(results.len == outOutputs.len);
+    const resultsPtr: [*c]c.SlangResult = if (outResults) |results| results.ptr else null;
+    return @enumFromInt(c.getAllTargetCode(linkedProgram, @intCast(outOutputs.len), outOutputs.ptr, resultsPtr, outDiagnostics));
+}
+
+/// Owning handle to one reference on a Slang blob.
+pub const Blob = struct {
+    handle: IBlob = null,
+
+    /// Takes over a reference the caller already holds, e.g. an out-parameter.
+    pub fn adopt(handle: IBlob) Blob {
+        return .{ .handle = handle };
+    }
+
+    pub fn retain(self: Blob) Blob {
+        if (self.handle != null) _ = c.addRef(self.handle);
+        return self;
+    }
+
+    pub fn release(self: *Blob) void {
+        if (self.handle != null) _ = c.release(self.handle);
+        self.handle = null;
+    }
+
+    pub fn bytes(self: Blob) []const u8 {
+        var slice: []const u8 = &.{};
+        if (self.handle != null) _ = getBlobSlice(self.handle, &slice);
+        return slice;
+    }
+
+    pub fn dupe(self: Blob, allocator: std.mem.Allocator) ![]u8 {
+        return allocator.dupe(u8, self.bytes());
+    }
+};
+
+pub fn addRef(unknown: Unknown) u32 {
+    return c.addRef(unknown);
+}
+
+pub fn copyTargetCode(linkedProgram: c.IComponentType, targetIndex: c.SlangInt, buffer: []u8, outSize: *usize, outDiagnostics: *c.IBlob) SlangResult {
+    return @enumFromInt(c.copyTargetCode(linkedProgram, targetIndex, buffer.ptr, buffer.len, outSize, outDiagnostics));
+}
+
+/// Generates code for `targetIndex` straight into memory from `allocator`.
+pub fn getTargetCodeAlloc(allocator: std.mem.Allocator, linkedProgram: c.IComponentType, targetIndex: c.SlangInt, outCode: *[]u8, outDiagnostics: *c.IBlob) !SlangResult {
+    var size: usize = 0;
+    var empty: [0]u8 = .{};
+    const query = copyTargetCode(linkedProgram, targetIndex, &empty, &size, outDiagnostics);
+    if (query != .BUFFER_TOO_SMALL and !query.isSuccess()) return query;
+
+    const code = try allocator.alloc(u8, size);
+    // Diagnostics were already reported by the size query.
+    var unused: c.IBlob = null;
+    defer _ = release(unused);
+    const result = copyTargetCode(linkedProgram, targetIndex, code, &size, &unused);
+    if (!result.isSuccess()) {
+        allocator.free(code);
+        return result;
+    }
+    outCode.* = code;
+    return result;
+}
+
 pub fn getBlobSlice(blob: c.IBlob, slice: *[]const u8) SlangResult {
     var p: *const anyopaque = undefined;
     var s: usize = undefined;
@@ -816,6 +970,249 @@ pub fn getBlobSlice(blob: c.IBlob, slice: *[]const u8) SlangResult {
     return result;
 }
 
+pub fn loadNamedModuleFromSourceStringTimed(ss: c.ISession, moduleName: [:0]const u8, path: [:0]const u8, sourceBuffer: [:0]const u8, outModule: *c.IModule, outDiagnostics: *c.IBlob, outTiming: *PhaseTiming) SlangResult {
+    return @enumFromInt(c.loadNamedModuleFromSourceStringTimed(ss, moduleName.ptr, path.ptr, sourceBuffer.ptr, outModule, outDiagnostics, outTiming));
+}
+
+pub fn linkProgramTimed(program: c.IComponentType, outLinkedProgram: *c.IComponentType, diagnostics: *IBlob, outTiming: *PhaseTiming) SlangResult {
+    return @enumFromInt(c.linkProgramTimed(program, outLinkedProgram, diagnostics, outTiming));
+}
+
+pub fn getTargetCodeTimed(linkedProgram: c.IComponentType, targetIndex: c.SlangInt, outOutput: *c.IBlob, outDiagnostics: *c.IBlob, outTiming: *PhaseTiming) SlangResult {
+    return @enumFromInt(c.getTargetCodeTimed(linkedProgram, targetIndex, outOutput, outDiagnostics, outTiming));
+}
+
+pub fn parsePerfBenchmark(text: []const u8, outEntries: []PerfBenchmarkEntry, outCount: *usize) SlangResult {
+    var count: c.SlangInt = 0;
+    const result: SlangResult = @enumFromInt(c.parsePerfBenchmark(text.ptr, text.len, outEntries.ptr, @intCast(outEntries.len), &count));
+    outCount.* = @intCast(count);
+    return result;
+}
+
+pub fn PerfBenchmarkEntry_getName(entry: *const PerfBenchmarkEntry) []const u8 {
+    return std.mem.sliceTo(&entry.name, 0);
+}
+
+pub fn compileBatch(ss: ISession, requests: []const CompileRequest, outResults: []CompileResult) SlangResult {
+    assert(requests.len == outResults.len);
+    return @enumFromInt(c.compileBatch(ss, requests.ptr, @intCast(requests.len), outResults.ptr));
+}
+
+pub fn compileBatchInNewSession(globalSession: c.IGlobalSession, sessionDesc: *const c.SessionDesc, requests: []const CompileRequest, outResults: []CompileResult) SlangResult {
+    assert(requests.len == outResults.len);
+    return @enumFromInt(c.compileBatchInNewSession(globalSession, sessionDesc, requests.ptr, @intCast(requests.len), outResults.ptr));
+}
+
+pub fn MemoryFileSystem_create(outFileSystem: *MemoryFileSystem) SlangResult {
+    return @enumFromInt(c.MemoryFileSystem_create(outFileSystem));
+}
+
+pub fn MemoryFileSystem_addFile(fileSystem: MemoryFileSystem, path: [:0]const u8, data: []const u8) SlangResult {
+    return @enumFromInt(c.MemoryFileSystem_addFile(fileSystem, path.ptr, data.ptr, data.len));
+}
+
+pub fn MemoryFileSystem_addBorrowedFile(fileSystem: MemoryFileSystem, path: [:0]const u8, data: []const u8, releaseData: ReleaseDataCallback, userData: ?*anyopaque) SlangResult {
+    return @enumFromInt(c.MemoryFileSystem_addBorrowedFile(fileSystem, path.ptr, data.ptr, data.len, releaseData, userData));
+}
+
+/// Maps `file` read-only and serves it at `path` without copying; the mapping
+/// is released once the file system and Slang are done with it.
+pub fn MemoryFileSystem_addMappedFile(fileSystem: MemoryFileSystem, path: [:0]const u8, file: std.fs.File) !SlangResult {
+    const size: usize = @intCast((try file.stat()).size);
+    if (size == 0) return MemoryFileSystem_addFile(fileSystem, path, "");
+
+    const mapped = try mapFile(file, size);
+    const result = MemoryFileSystem_addBorrowedFile(fileSystem, path, mapped, unmapFile, null);
+    if (!result.isSuccess()) std.posix.munmap(mapped);
+    return result;
+}
+
+pub fn MemoryFileSystem_removeFile(fileSystem: MemoryFileSystem, path: [:0]const u8) bool {
+    return c.MemoryFileSystem_removeFile(fileSystem, path.ptr);
+}
+
+pub fn MemoryFileSystem_getFileCount(fileSystem: MemoryFileSystem) c.SlangInt {
+    return c.MemoryFileSystem_getFileCount(fileSystem);
+}
+
+pub fn ModuleRegistry_create(ss: ISession, outRegistry: *ModuleRegistry) SlangResult {
+    return @enumFromInt(c.ModuleRegistry_create(ss, outRegistry));
+}
+
+pub fn ModuleRegistry_destroy(registry: ModuleRegistry) void {
+    c.ModuleRegistry_destroy(registry);
+}
+
+pub fn ModuleRegistry_load(registry: ModuleRegistry, moduleName: [:0]const u8, path: ?[:0]const u8, sourceBuffer: [:0]const u8, outModule: *IModule, outDiagnostics: *IBlob) SlangResult {
+    const pathPtr: [*c]const u8 = if (path) |p| p.ptr else null;
+    return @enumFromInt(c.ModuleRegistry_load(registry, moduleName.ptr, pathPtr, sourceBuffer.ptr, outModule, outDiagnostics));
+}
+
+pub fn ModuleRegistry_find(registry: ModuleRegistry, moduleName: [:0]const u8) IModule {
+    return c.ModuleRegistry_find(registry, moduleName.ptr);
+}
+
+pub fn ModuleRegistry_getCount(registry: ModuleRegistry) c.SlangInt {
+    return c.ModuleRegistry_getCount(registry);
+}
+
+pub fn CompileScheduler_create(sessionDesc: *const c.SessionDesc, threadCount: u32, maxJobsPerSession: u32, coreModuleCachePath: ?[*:0]const u8, outScheduler: *CompileScheduler) SlangResult {
+    const desc: c.CompileSchedulerDesc = .{
+        .threadCount = threadCount,
+        .maxJobsPerSession = maxJobsPerSession,
+        .coreModuleCachePath = coreModuleCachePath,
+    };
+    return @enumFromInt(c.CompileScheduler_create(sessionDesc, &desc, outScheduler));
+}
+
+pub fn CompileScheduler_destroy(scheduler: CompileScheduler) void {
+    c.CompileScheduler_destroy(scheduler);
+}
+
+pub fn CompileScheduler_getThreadCount(scheduler: CompileScheduler) u32 {
+    return c.CompileScheduler_getThreadCount(scheduler);
+}
+
+pub fn CompileScheduler_submit(scheduler: CompileScheduler, request: *const CompileRequest, outJob: *CompileJob) SlangResult {
+    return @enumFromInt(c.CompileScheduler_submit(scheduler, request, outJob));
+}
+
+pub fn CompileScheduler_wait(scheduler: CompileScheduler, job: CompileJob, outResult: *CompileResult) SlangResult {
+    return @enumFromInt(c.CompileScheduler_wait(scheduler, job, outResult));
+}
+
+pub fn CompileScheduler_waitAll(scheduler: CompileScheduler, jobs: []const CompileJob, outResults: []CompileResult) SlangResult {
+    assert(jobs.len == outResults.len);
+    return @enumFromInt(c.CompileScheduler_waitAll(scheduler, jobs.ptr, @intCast(jobs.len), outResults.ptr));
+}
+
+pub fn CompileScheduler_submitAsync(scheduler: CompileScheduler, request: *const CompileRequest, callback: CompileCallback, userData: ?*anyopaque, outJob: *CompileJob) SlangResult {
+    return @enumFromInt(c.CompileScheduler_submitAsync(scheduler, request, callback, userData, outJob));
+}
+
+pub fn CompileScheduler_tryWait(scheduler: CompileScheduler, job: CompileJob, outResult: *CompileResult) SlangResult {
+    return @enumFromInt(c.CompileScheduler_tryWait(scheduler, job, outResult));
+}
+
+pub fn CompileScheduler_getCompletionFd(scheduler: CompileScheduler) c_int {
+    return c.CompileScheduler_getCompletionFd(scheduler);
+}
+
+pub fn CompileScheduler_acknowledgeCompletions(scheduler: CompileScheduler) void {
+    c.CompileScheduler_acknowledgeCompletions(scheduler);
+}
+
+pub fn SessionPool_create(global: IGlobalSession, preloadModules: []const [*:0]const u8, maxUsesPerSession: u32, maxIdlePerKey: u32, outPool: *SessionPool) SlangResult {
+    const desc: c.SessionPoolDesc = .{
+        .preloadModules = @ptrCast(preloadModules.ptr),
+        .preloadModuleCount = @intCast(preloadModules.len),
+        .maxUsesPerSession = maxUsesPerSession,
+        .maxIdlePerKey = maxIdlePerKey,
+    };
+    return @enumFromInt(c.SessionPool_create(global, &desc, outPool));
+}
+
+pub fn SessionPool_destroy(pool: SessionPool) void {
+    c.SessionPool_destroy(pool);
+}
+
+pub fn SessionPool_prewarm(pool: SessionPool, sessionDesc: *const c.SessionDesc, count: u32, outDiagnostics: *IBlob) SlangResult {
+    return @enumFromInt(c.SessionPool_prewarm(pool, sessionDesc, count, outDiagnostics));
+}
+
+pub fn SessionPool_acquire(pool: SessionPool, sessionDesc: *const c.SessionDesc, outSession: *ISession, outDiagnostics: *IBlob) SlangResult {
+    return @enumFromInt(c.SessionPool_acquire(pool, sessionDesc, outSession, outDiagnostics));
+}
+
+pub fn SessionPool_release(pool: SessionPool, ss: ISession) SlangResult {
+    return @enumFromInt(c.SessionPool_release(pool, ss));
+}
+
+pub fn SessionPool_getIdleCount(pool: SessionPool) c.SlangInt {
+    return c.SessionPool_getIdleCount(pool);
+}
+
+/// `global` may be null once the directory has been opened with a global
+/// session, which lets `ReflectionSnapshot.mapCached` run before Slang starts.
+/// `fileSystem` is the `SessionDesc.fileSystem` the cached modules were
+/// loaded through, or null for the disk.
+pub fn CompileCache_open(global: IGlobalSession, directory: [:0]const u8, maxSizeBytes: u64, fileSystem: ?*anyopaque, outCache: *CompileCache) SlangResult {
+    const desc: c.CompileCacheDesc = .{ .directory = directory.ptr, .maxSizeBytes = maxSizeBytes, .fileSystem = fileSystem };
+    return @enumFromInt(c.CompileCache_open(global, &desc, outCache));
+}
+
+pub fn CompileCache_close(cache: CompileCache) void {
+    c.CompileCache_close(cache);
+}
+
+pub fn CompileCache_computeKey(cache: CompileCache, sessionDesc: *const c.SessionDesc, source: []const u8, entryPointName: [:0]const u8, stage: Stage, targetIndex: c.SlangInt, outKey: *CompileCacheKey) SlangResult {
+    return @enumFromInt(c.CompileCache_computeKey(cache, sessionDesc, source.ptr, source.len, entryPointName.ptr, @intFromEnum(stage), targetIndex, outKey));
+}
+
+pub fn CompileCache_load(cache: CompileCache, key: *const CompileCacheKey, outCode: *IBlob, outDiagnostics: *IBlob) SlangResult {
+    return @enumFromInt(c.CompileCache_load(cache, key, outCode, outDiagnostics));
+}
+
+pub fn CompileCache_store(cache: CompileCache, key: *const CompileCacheKey, module: IModule, code: IBlob, diagnostics: IBlob) SlangResult {
+    return @enumFromInt(c.CompileCache_store(cache, key, module, code, diagnostics));
+}
+
+pub fn CompileCache_storeReflection(cache: CompileCache, key: *const CompileCacheKey, layout: c.ProgramLayout) SlangResult {
+    return @enumFromInt(c.CompileCache_storeReflection(cache, key, layout));
+}
+
+pub fn CompileCache_getTotalSize(cache: CompileCache) u64 {
+    return c.CompileCache_getTotalSize(cache);
+}
+
+pub fn SpecializationCache_create(layout: c.ProgramLayout, outCache: *SpecializationCache) SlangResult {
+    return @enumFromInt(c.SpecializationCache_create(layout, outCache));
+}
+
+pub fn SpecializationCache_destroy(cache: SpecializationCache) void {
+    c.SpecializationCache_destroy(cache);
+}
+
+pub fn SpecializationCache_specializeType(cache: SpecializationCache, t: TypeReflectionPtr, args: []const TypeReflectionPtr, outDiagnostics: *IBlob) TypeReflectionPtr {
+    return c.SpecializationCache_specializeType(cache, t, @intCast(args.len), args.ptr, outDiagnostics);
+}
+
+pub fn SpecializationCache_specializeGeneric(cache: SpecializationCache, generic: GenericReflectionPtr, argTypes: []const c.GenericArgType, argVals: []const c.GenericArgReflectionPtr, outDiagnostics: *IBlob) GenericReflectionPtr {
+    assert(argTypes.len == argVals.len);
+    return c.SpecializationCache_specializeGeneric(cache, generic, @intCast(argTypes.len), argTypes.ptr, argVals.ptr, outDiagnostics);
+}
+
+pub fn SpecializationCache_specializeFunction(cache: SpecializationCache, function: FunctionReflectionPtr, argTypes: []const TypeReflectionPtr) FunctionReflectionPtr {
+    return c.SpecializationCache_specializeFunction(cache, function, @intCast(argTypes.len), argTypes.ptr);
+}
+
+/// `args` holds `outTypes.len` argument sets of `argCount` types each.
+pub fn SpecializationCache_specializeTypes(cache: SpecializationCache, t: TypeReflectionPtr, argCount: usize, args: []const TypeReflectionPtr, outTypes: []TypeReflectionPtr, outDiagnostics: *IBlob) SlangResult {
+    assert(args.len == argCount * outTypes.len);
+    return @enumFromInt(c.SpecializationCache_specializeTypes(cache, t, @intCast(outTypes.len), @intCast(argCount), args.ptr, outTypes.ptr, outDiagnostics));
+}
+
+/// `argTypes` and `argVals` hold `outGenerics.len` argument sets of `argCount` entries each.
+pub fn SpecializationCache_specializeGenerics(cache: SpecializationCache, generic: GenericReflectionPtr, argCount: usize, argTypes: []const c.GenericArgType, argVals: []const c.GenericArgReflectionPtr, outGenerics: []GenericReflectionPtr, outDiagnostics: *IBlob) SlangResult {
+    assert(argTypes.len == argCount * outGenerics.len and argVals.len == argTypes.len);
+    return @enumFromInt(c.SpecializationCache_specializeGenerics(cache, generic, @intCast(outGenerics.len), @intCast(argCount), argTypes.ptr, argVals.ptr, outGenerics.ptr, outDiagnostics));
+}
+
+/// `argTypes` holds `outFunctions.len` argument sets of `argCount` types each.
+pub fn SpecializationCache_specializeFunctions(cache: SpecializationCache, function: FunctionReflectionPtr, argCount: usize, argTypes: []const TypeReflectionPtr, outFunctions: []FunctionReflectionPtr) SlangResult {
+    assert(argTypes.len == argCount * outFunctions.len);
+    return @enumFromInt(c.SpecializationCache_specializeFunctions(cache, function, @intCast(outFunctions.len), @intCast(argCount), argTypes.ptr, outFunctions.ptr));
+}
+
+pub fn SpecializationCache_getEntryCount(cache: SpecializationCache) c.SlangInt {
+    return c.SpecializationCache_getEntryCount(cache);
+}
+
+/// See `ReflectionSnapshot.capture` for an allocating wrapper.
+pub fn writeReflectionSnapshot(layout: c.ProgramLayout, buffer: ?*anyopaque, bufferSize: usize, outSize: *usize) SlangResult {
+    return @enumFromInt(c.writeReflectionSnapshot(layout, buffer, bufferSize, outSize));
+}
+
 pub fn ProgramLayout_getParameterCount(layout: c.ProgramLayout) u32 {
     return @intCast(c.ProgramLayout_getParameterCount(layout));
 }
@@ -1362,6 +1759,10 @@ pub fn IMetadata_isParameterLocationUsed(inMetadata: IMetadata, category: Parame
     return @enumFromInt(c.IMetadata_isParameterLocationUsed(inMetadata, @intFromEnum(category), spaceInt, registerInt, outUsed));
 }
 
+pub fn IMetadata_getParameterUsage(inMetadata: IMetadata, category: ParameterCategory, spaceCount: u64, registerCount: u64, outWords: []u64) SlangResult {
+    return @enumFromInt(c.IMetadata_getParameterUsage(inMetadata, @intFromEnum(category), spaceCount, registerCount, outWords.ptr, outWords.len));
+}
+
 pub fn AttributeReflection_getName(self: AttributeReflectionPtr) []const u8 {
     return std.mem.sliceTo(c.AttributeReflection_getName(self), 0);
 }
@@ -1455,8 +1856,15 @@ pub fn init() void {
     assert(createGlobalSession(&gs).isSuccess());
 }
 
+pub fn initWithCoreModuleCache(cachePath: [:0]const u8) void {
+    gs = std.mem.zeroes(c.IGlobalSession);
+    assert(createGlobalSessionWithCoreModuleCache(cachePath, &gs).isSuccess());
+}
+
 pub fn deinit() void {
     _ = c.release(gs);
+    names.deinit();
+    names = .init(std.heap.smp_allocator);
 }
 
 pub fn IModule_findEntryPointByName(inModule: IModule, name: []const u8, entryPoint: *IEntryPoint) SlangResult {
@@ -1514,3 +1922,11 @@ pub fn IModule_disassemble(inModule: IModule, outDisassembledBlob: *IBlob) Slang
 pub fn IEntryPoint_getFunctionReflection(inEntryPoint: IEntryPoint) FunctionReflectionPtr {
     return c.IEntryPoint_getFunctionReflection(inEntryPoint);
 }
+
+test {
+    _ = VariantSet;
+    _ = ReflectionSnapshot;
+    _ = StringTable;
+    _ = ParameterUsage;
+    _ = DescriptorSetLayouts;
+}
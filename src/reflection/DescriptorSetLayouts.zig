@@ -0,0 +1,370 @@
+//! Vulkan-style descriptor set layouts for a whole program, flattened from a
+//! `ReflectionSnapshot` in one pass. Sets are sorted by space and their
+//! ranges by binding, so creating a pipeline layout is a copy out of
+//! `sets`/`ranges`. Each set carries a structural hash over its ranges (not
+//! its space), which lets identical set layouts be created once and shared
+//! across programs.
+//!
+//! Global parameters are visible to every stage of the program's entry
+//! points; entry point parameters only to their own stage. A binding
+//! declared in several scopes ends up as one range with the stages OR-ed,
+//! provided every declaration agrees on its type and descriptor count.
+
+const std = @import("std");
+const lib = @import("../lib.zig");
+const Snapshot = @import("Snapshot.zig");
+
+const c = lib.c;
+
+const Self = @This();
+
+pub const Error = error{
+    OutOfMemory,
+    /// Two declarations of one (space, binding) disagree on the binding type
+    /// or descriptor count, so no single range describes both.
+    ConflictingBinding,
+};
+
+pub const Range = extern struct {
+    binding: u32,
+    /// `lib.BindingType`.
+    bindingType: u32,
+    /// `lib.ParameterCategory`.
+    category: u32,
+    /// Bit `1 << stage` for each `lib.Stage` that can access the range.
+    stageMask: u32,
+    /// Negative for unbounded arrays, as reported by Slang.
+    descriptorCount: i64,
+};
+
+pub const Set = extern struct {
+    space: u32,
+    /// ranges[rangeFirst, +rangeCount)
+    rangeFirst: u32,
+    rangeCount: u32,
+    reserved: u32 = 0,
+    hash: u64,
+};
+
+allocator: std.mem.Allocator,
+sets: []Set,
+ranges: []Range,
+
+const Entry = struct {
+    space: u32,
+    range: Range,
+
+    fn lessThan(_: void, a: Entry, b: Entry) bool {
+        if (a.space != b.space) return a.space < b.space;
+        return a.range.binding < b.range.binding;
+    }
+};
+
+const Builder = struct {
+    allocator: std.mem.Allocator,
+    snapshot: *const Snapshot,
+    entries: std.ArrayList(Entry) = .empty,
+
+    fn isDescriptor(bindingType: u32) bool {
+        return switch (bindingType & c.SLANG_BINDING_TYPE_BASE_MASK) {
+            c.SLANG_BINDING_TYPE_UNKNOWN,
+            c.SLANG_BINDING_TYPE_VARYING_INPUT,
+            c.SLANG_BINDING_TYPE_VARYING_OUTPUT,
+            c.SLANG_BINDING_TYPE_EXISTENTIAL_VALUE,
+            c.SLANG_BINDING_TYPE_PUSH_CONSTANT,
+            => false,
+            else => true,
+        };
+    }
+
+    fn isBlock(variable: *const Snapshot.Variable, t: *const Snapshot.Type) bool {
+        return Snapshot.getKind(t) == .PARAMETER_BLOCK and
+            (variable.category == @intFromEnum(lib.ParameterCategory.SUB_ELEMENT_REGISTER_SPACE) or
+                variable.category == @intFromEnum(lib.ParameterCategory.REGISTER_SPACE));
+    }
+
+    /// Adds the descriptor ranges `t` owns, offset by the location of the
+    /// variable that holds it.
+    fn addType(self: *Builder, t: *const Snapshot.Type, spaceBase: u32, bindingBase: u32, stageMask: u32) error{OutOfMemory}!void {
+        for (self.snapshot.getDescriptorSets(t)) |*set| {
+            for (self.snapshot.getDescriptorRanges(set)) |range| {
+                if (!isDescriptor(range.bindingType)) continue;
+                try self.entries.append(self.allocator, .{
+                    .space = spaceBase + set.spaceOffset,
+                    .range = .{
+                        .binding = bindingBase + range.indexOffset,
+                        .bindingType = range.bindingType,
+                        .category = range.category,
+                        .stageMask = stageMask,
+                        .descriptorCount = range.descriptorCount,
+                    },
+                });
+            }
+        }
+    }
+
+    /// Parameter blocks own their sets instead of contributing ranges to the
+    /// enclosing type, so they are found by walking fields.
+    fn addBlocks(self: *Builder, t: *const Snapshot.Type, spaceBase: u32, stageMask: u32) error{OutOfMemory}!void {
+        for (self.snapshot.getFields(t)) |*field| {
+            const fieldType = self.snapshot.getType(field.type) orelse continue;
+            if (isBlock(field, fieldType)) {
+                try self.addBlock(fieldType, spaceBase + field.bindingIndex, stageMask);
+            } else if (Snapshot.getKind(fieldType) == .STRUCT) {
+                try self.addBlocks(fieldType, spaceBase + field.bindingSpace, stageMask);
+            }
+        }
+    }
+
+    fn addBlock(self: *Builder, block: *const Snapshot.Type, space: u32, stageMask: u32) error{OutOfMemory}!void {
+        try self.addType(block, space, 0, stageMask);
+        if (self.snapshot.getType(block.elementType)) |element| {
+            try self.addBlocks(element, space, stageMask);
+        }
+    }
+
+    fn addParameter(self: *Builder, parameter: *const Snapshot.Variable, stageMask: u32) error{OutOfMemory}!void {
+        const t = self.snapshot.getType(parameter.type) orelse return;
+        if (isBlock(parameter, t)) {
+            try self.addBlock(t, parameter.bindingIndex, stageMask);
+        } else {
+            try self.addType(t, parameter.bindingSpace, parameter.bindingIndex, stageMask);
+            try self.addBlocks(t, parameter.bindingSpace, stageMask);
+        }
+    }
+};
+
+fn stageBit(stage: u32) u32 {
+    return if (stage < 32) @as(u32, 1) << @intCast(stage) else 0;
+}
+
+/// Structural hash of a set's ranges. It only depends on the snapshot
+/// contents, so it is stable across runs and can key an on-disk cache.
+fn hashRanges(ranges: []const Range) u64 {
+    var hasher = std.hash.Wyhash.init(0);
+    for (ranges) |range| hasher.update(std.mem.asBytes(&range));
+    return hasher.final();
+}
+
+pub fn init(allocator: std.mem.Allocator, snapshot: *const Snapshot) Error!Self {
+    var builder: Builder = .{ .allocator = allocator, .snapshot = snapshot };
+    defer builder.entries.deinit(allocator);
+
+    var allStages: u32 = 0;
+    for (snapshot.entryPoints) |entryPoint| allStages |= stageBit(entryPoint.stage);
+
+    if (snapshot.getGlobalParamsType()) |globals| {
+        // Global ranges are already relative to space 0, binding 0.
+        try builder.addType(globals, 0, 0, allStages);
+        // Globals wrapped in an implicit constant buffer or parameter block
+        // keep their fields on the element type.
+        const fields = switch (Snapshot.getKind(globals)) {
+            .CONSTANT_BUFFER, .PARAMETER_BLOCK => snapshot.getType(globals.elementType) orelse globals,
+            else => globals,
+        };
+        try builder.addBlocks(fields, 0, allStages);
+    }
+    for (snapshot.entryPoints) |*entryPoint| {
+        for (snapshot.getEntryPointParameters(entryPoint)) |*parameter| {
+            try builder.addParameter(parameter, stageBit(entryPoint.stage));
+        }
+    }
+
+    const entries = builder.entries.items;
+    std.mem.sort(Entry, entries, {}, Entry.lessThan);
+
+    // Merge duplicates in place, then cut the sorted list into sets.
+    var rangeCount: usize = 0;
+    var setCount: usize = 0;
+    for (entries, 0..) |entry, i| {
+        if (rangeCount > 0) {
+            const last = &entries[rangeCount - 1];
+            if (last.space == entry.space and last.range.binding == entry.range.binding) {
+                if (last.range.bindingType != entry.range.bindingType or
+                    last.range.descriptorCount != entry.range.descriptorCount)
+                {
+                    return error.ConflictingBinding;
+                }
+                last.range.stageMask |= entry.range.stageMask;
+                continue;
+            }
+        }
+        if (rangeCount == 0 or entries[rangeCount - 1].space != entry.space) setCount += 1;
+        entries[rangeCount] = entries[i];
+        rangeCount += 1;
+    }
+
+    const ranges = try allocator.alloc(Range, rangeCount);
+    errdefer allocator.free(ranges);
+    const sets = try allocator.alloc(Set, setCount);
+
+    var set: usize = 0;
+    var first: usize = 0;
+    for (entries[0..rangeCount], 0..) |entry, i| {
+        ranges[i] = entry.range;
+        const isLast = i + 1 == rangeCount or entries[i + 1].space != entry.space;
+        if (!isLast) continue;
+        sets[set] = .{
+            .space = entry.space,
+            .rangeFirst = @intCast(first),
+            .rangeCount = @intCast(i + 1 - first),
+            .hash = hashRanges(ranges[first .. i + 1]),
+        };
+        set += 1;
+        first = i + 1;
+    }
+
+    return .{ .allocator = allocator, .sets = sets, .ranges = ranges };
+}
+
+pub fn deinit(self: *Self) void {
+    self.allocator.free(self.sets);
+    self.allocator.free(self.ranges);
+    self.* = undefined;
+}
+
+pub fn getRanges(self: *const Self, set: *const Set) []const Range {
+    return self.ranges[set.rangeFirst..][0..set.rangeCount];
+}
+
+pub fn findSet(self: *const Self, space: u32) ?*const Set {
+    for (self.sets) |*set| {
+        if (set.space == space) return set;
+    }
+    return null;
+}
+
+/// Whether two sets can share one layout object.
+pub fn setsEqual(self: *const Self, a: *const Set, other: *const Self, b: *const Set) bool {
+    return a.hash == b.hash and std.mem.eql(u8, std.mem.sliceAsBytes(self.getRanges(a)), std.mem.sliceAsBytes(other.getRanges(b)));
+}
+
+const testing = std.testing;
+const snapshot_testing = @import("snapshot_testing.zig");
+
+const texture_range: Snapshot.DescriptorRange = .{
+    .bindingType = c.SLANG_BINDING_TYPE_TEXTURE,
+    .category = c.SLANG_PARAMETER_CATEGORY_DESCRIPTOR_TABLE_SLOT,
+    .descriptorCount = 1,
+};
+const test_descriptorRanges = [_]Snapshot.DescriptorRange{
+    texture_range,
+    .{
+        .bindingType = c.SLANG_BINDING_TYPE_CONSTANT_BUFFER,
+        .category = c.SLANG_PARAMETER_CATEGORY_DESCRIPTOR_TABLE_SLOT,
+        .descriptorCount = 1,
+    },
+    .{
+        .indexOffset = 5,
+        .bindingType = texture_range.bindingType,
+        .category = texture_range.category,
+        .descriptorCount = 1,
+    },
+    .{
+        .bindingType = texture_range.bindingType,
+        .category = texture_range.category,
+        .descriptorCount = 4,
+    },
+};
+const test_descriptorSets = [_]Snapshot.DescriptorSet{
+    .{ .descriptorRangeFirst = 0, .descriptorRangeCount = 1 },
+    .{ .descriptorRangeFirst = 1, .descriptorRangeCount = 1 },
+    .{ .spaceOffset = 1, .descriptorRangeFirst = 2, .descriptorRangeCount = 1 },
+    .{ .descriptorRangeFirst = 3, .descriptorRangeCount = 1 },
+};
+const texture_type = 0;
+const constant_buffer_type = 1;
+const globals_type = 2;
+const texture_array_type = 3;
+const test_types = [_]Snapshot.Type{
+    .{ .kind = @intFromEnum(lib.TypeKind.RESOURCE), .descriptorSetFirst = 0, .descriptorSetCount = 1 },
+    .{ .kind = @intFromEnum(lib.TypeKind.CONSTANT_BUFFER), .descriptorSetFirst = 1, .descriptorSetCount = 1 },
+    // Globals holding one texture at space 1, binding 5.
+    .{ .kind = @intFromEnum(lib.TypeKind.STRUCT), .descriptorSetFirst = 2, .descriptorSetCount = 1 },
+    .{ .kind = @intFromEnum(lib.TypeKind.ARRAY), .descriptorSetFirst = 3, .descriptorSetCount = 1 },
+};
+
+fn testParameter(t: u32, space: u32, binding: u32) Snapshot.Variable {
+    return .{ .type = t, .bindingSpace = space, .bindingIndex = binding };
+}
+
+fn testEntryPoint(stage: lib.Stage, parameterFirst: u32, parameterCount: u32) Snapshot.EntryPoint {
+    return .{ .stage = @intFromEnum(stage), .parameterFirst = parameterFirst, .parameterCount = parameterCount };
+}
+
+fn initForTest(variables: []const Snapshot.Variable, entryPoints: []const Snapshot.EntryPoint, globalParamsType: u32) !Self {
+    const bytes = try snapshot_testing.build(testing.allocator, .{
+        .types = &test_types,
+        .variables = variables,
+        .descriptorSets = &test_descriptorSets,
+        .descriptorRanges = &test_descriptorRanges,
+        .entryPoints = entryPoints,
+        .globalParamsType = globalParamsType,
+    });
+    defer testing.allocator.free(bytes);
+    const snapshot = try Snapshot.init(bytes);
+    return init(testing.allocator, &snapshot);
+}
+
+test "DescriptorSetLayouts: duplicate bindings merge their stages" {
+    const vertex = stageBit(@intFromEnum(lib.Stage.VERTEX));
+    const fragment = stageBit(@intFromEnum(lib.Stage.FRAGMENT));
+    var layouts = try initForTest(&.{
+        testParameter(texture_type, 0, 3),
+        testParameter(texture_type, 0, 0),
+        testParameter(texture_type, 0, 0),
+    }, &.{
+        testEntryPoint(.VERTEX, 0, 2),
+        testEntryPoint(.FRAGMENT, 2, 1),
+    }, globals_type);
+    defer layouts.deinit();
+
+    try testing.expectEqual(@as(usize, 2), layouts.sets.len);
+    const set0 = layouts.findSet(0).?;
+    const ranges0 = layouts.getRanges(set0);
+    try testing.expectEqual(@as(usize, 2), ranges0.len);
+    try testing.expectEqual(@as(u32, 0), ranges0[0].binding);
+    try testing.expectEqual(vertex | fragment, ranges0[0].stageMask);
+    try testing.expectEqual(@as(u32, 3), ranges0[1].binding);
+    try testing.expectEqual(vertex, ranges0[1].stageMask);
+
+    const ranges1 = layouts.getRanges(layouts.findSet(1).?);
+    try testing.expectEqual(@as(usize, 1), ranges1.len);
+    try testing.expectEqual(@as(u32, 5), ranges1[0].binding);
+    try testing.expectEqual(vertex | fragment, ranges1[0].stageMask);
+    try testing.expectEqual(@as(?*const Set, null), layouts.findSet(2));
+}
+
+test "DescriptorSetLayouts: disagreeing declarations of one binding conflict" {
+    for ([_]u32{ constant_buffer_type, texture_array_type }) |other| {
+        try testing.expectError(error.ConflictingBinding, initForTest(&.{
+            testParameter(texture_type, 0, 0),
+            testParameter(other, 0, 0),
+        }, &.{
+            testEntryPoint(.VERTEX, 0, 1),
+            testEntryPoint(.FRAGMENT, 1, 1),
+        }, Snapshot.none));
+    }
+}
+
+test "DescriptorSetLayouts: identical sets hash and compare equal" {
+    const variables = [_]Snapshot.Variable{
+        testParameter(texture_type, 0, 0),
+        testParameter(texture_type, 2, 0),
+        testParameter(constant_buffer_type, 1, 0),
+    };
+    const entryPoints = [_]Snapshot.EntryPoint{testEntryPoint(.COMPUTE, 0, variables.len)};
+    var layouts = try initForTest(&variables, &entryPoints, Snapshot.none);
+    defer layouts.deinit();
+    var other = try initForTest(&variables, &entryPoints, Snapshot.none);
+    defer other.deinit();
+
+    const set0 = layouts.findSet(0).?;
+    const set1 = layouts.findSet(1).?;
+    const set2 = layouts.findSet(2).?;
+    try testing.expectEqual(set0.hash, set2.hash);
+    try testing.expect(layouts.setsEqual(set0, &layouts, set2));
+    try testing.expect(layouts.setsEqual(set0, &other, other.findSet(2).?));
+    try testing.expect(set0.hash != set1.hash);
+    try testing.expect(!layouts.setsEqual(set0, &layouts, set1));
+}
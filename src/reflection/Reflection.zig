@@ -119,3 +119,9 @@ pub fn isParameterLocationUsed(self: *const Self, category: lib.ParameterCategor
     assert(lib.IMetadata_isParameterLocationUsed(self.metadata, category, space, index, &used).isSuccess());
     return used;
 }
+
+/// Usage of every `category` location below `spaceCount` and `registerCount`
+/// in one call; prefer this over `isParameterLocationUsed` for many slots.
+pub fn getParameterUsage(self: *const Self, allocator: std.mem.Allocator, category: lib.ParameterCategory, spaceCount: u32, registerCount: u32) !lib.ParameterUsage {
+    return lib.ParameterUsage.capture(allocator, self.metadata, category, spaceCount, registerCount);
+}
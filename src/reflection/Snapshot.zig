@@ -0,0 +1,328 @@
+//! Zero-copy view over a flat reflection snapshot written by
+//! `writeReflectionSnapshot`. Every accessor slices straight into the
+//! snapshot bytes, so reflecting a program is one FFI call followed by plain
+//! memory reads.
+
+const std = @import("std");
+const lib = @import("../lib.zig");
+
+const c = lib.c;
+
+const Self = @This();
+
+pub const Header = c.ReflectionSnapshotHeader;
+pub const Type = c.ReflectionSnapshotType;
+pub const Variable = c.ReflectionSnapshotVariable;
+pub const BindingRange = c.ReflectionSnapshotBindingRange;
+pub const DescriptorSet = c.ReflectionSnapshotDescriptorSet;
+pub const DescriptorRange = c.ReflectionSnapshotDescriptorRange;
+pub const EntryPoint = c.ReflectionSnapshotEntryPoint;
+
+pub const none: u32 = c.SLANGC_REFLECTION_NONE;
+
+pub const Error = error{
+    InvalidSnapshot,
+    UnsupportedVersion,
+};
+
+header: *const Header,
+types: []const Type,
+variables: []const Variable,
+bindingRanges: []const BindingRange,
+descriptorSets: []const DescriptorSet,
+descriptorRanges: []const DescriptorRange,
+entryPoints: []const EntryPoint,
+strings: []const u8,
+
+fn section(comptime T: type, bytes: []align(8) const u8, s: c.ReflectionSnapshotSection) Error![]const T {
+    const size = std.math.mul(usize, s.count, @sizeOf(T)) catch return error.InvalidSnapshot;
+    if (s.offset % @alignOf(T) != 0 or s.offset > bytes.len or size > bytes.len - s.offset) {
+        return error.InvalidSnapshot;
+    }
+    const start: [*]const T = @ptrCast(@alignCast(bytes.ptr + s.offset));
+    return start[0..s.count];
+}
+
+/// Validates the section table of `bytes` and returns a view over it. The
+/// bytes must stay alive and unmodified for as long as the view is used.
+pub fn init(bytes: []align(8) const u8) Error!Self {
+    if (bytes.len < @sizeOf(Header)) return error.InvalidSnapshot;
+    const header: *const Header = @ptrCast(bytes.ptr);
+    if (header.magic != c.SLANGC_REFLECTION_SNAPSHOT_MAGIC) return error.InvalidSnapshot;
+    if (header.version != c.SLANGC_REFLECTION_SNAPSHOT_VERSION) return error.UnsupportedVersion;
+    if (header.totalSize > bytes.len) return error.InvalidSnapshot;
+    const snapshot: Self = .{
+        .header = header,
+        .types = try section(Type, bytes, header.types),
+        .variables = try section(Variable, bytes, header.variables),
+        .bindingRanges = try section(BindingRange, bytes, header.bindingRanges),
+        .descriptorSets = try section(DescriptorSet, bytes, header.descriptorSets),
+        .descriptorRanges = try section(DescriptorRange, bytes, header.descriptorRanges),
+        .entryPoints = try section(EntryPoint, bytes, header.entryPoints),
+        .strings = try section(u8, bytes, header.strings),
+    };
+    if (snapshot.strings.len == 0 or snapshot.strings[snapshot.strings.len - 1] != 0) {
+        return error.InvalidSnapshot;
+    }
+    if (!rangeInBounds(header.parameterFirst, header.parameterCount, snapshot.variables.len)) {
+        return error.InvalidSnapshot;
+    }
+    for (snapshot.types) |t| {
+        if (!rangeInBounds(t.fieldFirst, t.fieldCount, snapshot.variables.len) or
+            !rangeInBounds(t.bindingRangeFirst, t.bindingRangeCount, snapshot.bindingRanges.len) or
+            !rangeInBounds(t.descriptorSetFirst, t.descriptorSetCount, snapshot.descriptorSets.len))
+        {
+            return error.InvalidSnapshot;
+        }
+    }
+    for (snapshot.descriptorSets) |set| {
+        if (!rangeInBounds(set.descriptorRangeFirst, set.descriptorRangeCount, snapshot.descriptorRanges.len)) {
+            return error.InvalidSnapshot;
+        }
+    }
+    for (snapshot.entryPoints) |entryPoint| {
+        if (!rangeInBounds(entryPoint.parameterFirst, entryPoint.parameterCount, snapshot.variables.len)) {
+            return error.InvalidSnapshot;
+        }
+    }
+    return snapshot;
+}
+
+fn rangeInBounds(first: u32, count: u32, len: usize) bool {
+    return @as(u64, first) + count <= len;
+}
+
+/// Captures `layout` into memory owned by the caller; free with
+/// `allocator.free`. `sizeHint` is the first buffer size tried, so passing the
+/// size of an earlier snapshot of a similar program usually walks the layout
+/// only once.
+pub fn capture(allocator: std.mem.Allocator, layout: lib.ProgramLayout, sizeHint: usize) ![]align(8) u8 {
+    var capacity = @max(sizeHint, @sizeOf(Header));
+    while (true) {
+        const buffer = try allocator.alignedAlloc(u8, .@"8", capacity);
+        var size: usize = 0;
+        const result = lib.writeReflectionSnapshot(layout, buffer.ptr, buffer.len, &size);
+        if (result.isSuccess()) {
+            // Keeping the slack is harmless if the allocator cannot shrink.
+            return allocator.realloc(buffer, size) catch buffer;
+        }
+        allocator.free(buffer);
+        if (result != .BUFFER_TOO_SMALL) return error.FailedToCaptureReflection;
+        capacity = size;
+    }
+}
+
+/// A snapshot read from a file with `mmap`. The kernel pages it in on first
+/// touch, so opening a large snapshot costs about as much as opening the file.
+pub const Mapped = struct {
+    bytes: []align(std.heap.page_size_min) const u8,
+    snapshot: Self,
+
+    pub fn deinit(self: *Mapped) void {
+        std.posix.munmap(self.bytes);
+        self.* = undefined;
+    }
+};
+
+/// Maps the snapshot at `path` and validates it.
+pub fn mapFile(path: []const u8) !Mapped {
+    const file = try std.fs.cwd().openFile(path, .{});
+    defer file.close();
+    const size: usize = @intCast((try file.stat()).size);
+    if (size < @sizeOf(Header)) return error.InvalidSnapshot;
+    const bytes = try lib.mapFile(file, size);
+    errdefer std.posix.munmap(bytes);
+    return .{ .bytes = bytes, .snapshot = try init(bytes) };
+}
+
+/// Maps the snapshot `CompileCache_storeReflection` wrote for `key` in the
+/// cache `directory`. Needs no Slang calls, so the reflection of a cached
+/// program is available before the global session exists; load the code with
+/// `CompileCache_load` first so a stale entry is not picked up.
+pub fn mapCached(directory: []const u8, key: *const lib.CompileCacheKey) !Mapped {
+    var buffer: [std.fs.max_path_bytes]u8 = undefined;
+    const hex = std.fmt.bytesToHex(key.bytes, .lower);
+    const path = try std.fmt.bufPrint(&buffer, "{s}/{s}.slrf", .{ directory, &hex });
+    return mapFile(path);
+}
+
+pub fn getString(self: *const Self, offset: u32) []const u8 {
+    if (offset >= self.strings.len) return "";
+    return std.mem.sliceTo(self.strings[offset..], 0);
+}
+
+pub fn getType(self: *const Self, index: u32) ?*const Type {
+    return if (index < self.types.len) &self.types[index] else null;
+}
+
+pub fn getParameters(self: *const Self) []const Variable {
+    return self.variables[self.header.parameterFirst..][0..self.header.parameterCount];
+}
+
+pub fn findParameter(self: *const Self, name: []const u8) ?*const Variable {
+    for (self.getParameters()) |*parameter| {
+        if (std.mem.eql(u8, self.getString(parameter.name), name)) return parameter;
+    }
+    return null;
+}
+
+pub fn getGlobalParamsType(self: *const Self) ?*const Type {
+    return self.getType(self.header.globalParamsType);
+}
+
+pub fn getFields(self: *const Self, t: *const Type) []const Variable {
+    return self.variables[t.fieldFirst..][0..t.fieldCount];
+}
+
+pub fn getBindingRanges(self: *const Self, t: *const Type) []const BindingRange {
+    return self.bindingRanges[t.bindingRangeFirst..][0..t.bindingRangeCount];
+}
+
+pub fn getDescriptorSets(self: *const Self, t: *const Type) []const DescriptorSet {
+    return self.descriptorSets[t.descriptorSetFirst..][0..t.descriptorSetCount];
+}
+
+pub fn getDescriptorRanges(self: *const Self, set: *const DescriptorSet) []const DescriptorRange {
+    return self.descriptorRanges[set.descriptorRangeFirst..][0..set.descriptorRangeCount];
+}
+
+pub fn getEntryPointParameters(self: *const Self, entryPoint: *const EntryPoint) []const Variable {
+    return self.variables[entryPoint.parameterFirst..][0..entryPoint.parameterCount];
+}
+
+pub fn findEntryPoint(self: *const Self, name: []const u8) ?*const EntryPoint {
+    for (self.entryPoints) |*entryPoint| {
+        if (std.mem.eql(u8, self.getString(entryPoint.name), name)) return entryPoint;
+    }
+    return null;
+}
+
+pub fn getKind(t: *const Type) lib.TypeKind {
+    return @enumFromInt(t.kind);
+}
+
+const testing = std.testing;
+const snapshot_testing = @import("snapshot_testing.zig");
+
+const test_types = [_]Type{
+    .{ .kind = @intFromEnum(lib.TypeKind.STRUCT), .fieldFirst = 0, .fieldCount = 1 },
+    .{ .kind = @intFromEnum(lib.TypeKind.SCALAR) },
+};
+const test_variables = [_]Variable{
+    .{ .name = 1, .type = 1 },
+};
+const test_descriptorSets = [_]DescriptorSet{
+    .{ .descriptorRangeFirst = 0, .descriptorRangeCount = 0 },
+};
+const test_entryPoints = [_]EntryPoint{
+    .{ .name = 3, .stage = @intFromEnum(lib.Stage.COMPUTE), .parameterFirst = 0, .parameterCount = 1 },
+};
+const test_parts: snapshot_testing.Parts = .{
+    .types = &test_types,
+    .variables = &test_variables,
+    .descriptorSets = &test_descriptorSets,
+    .entryPoints = &test_entryPoints,
+    .strings = "\x00x\x00main\x00",
+    .parameterFirst = 0,
+    .parameterCount = 1,
+    .globalParamsType = 0,
+};
+
+fn expectInit(expected: Error, parts: snapshot_testing.Parts) !void {
+    const bytes = try snapshot_testing.build(testing.allocator, parts);
+    defer testing.allocator.free(bytes);
+    try testing.expectError(expected, init(bytes));
+}
+
+test "Snapshot: init reads a well-formed snapshot" {
+    const bytes = try snapshot_testing.build(testing.allocator, test_parts);
+    defer testing.allocator.free(bytes);
+    const snapshot = try init(bytes);
+
+    try testing.expectEqual(@as(usize, 2), snapshot.types.len);
+    try testing.expectEqual(&snapshot.types[0], snapshot.getGlobalParamsType().?);
+    try testing.expectEqual(@as(usize, 1), snapshot.getFields(&snapshot.types[0]).len);
+    try testing.expect(snapshot.findParameter("x") != null);
+    const entryPoint = snapshot.findEntryPoint("main").?;
+    try testing.expectEqualStrings("x", snapshot.getString(snapshot.getEntryPointParameters(entryPoint)[0].name));
+    try testing.expectEqualStrings("", snapshot.getString(@intCast(snapshot.strings.len)));
+}
+
+test "Snapshot: init rejects a bad header" {
+    const bytes = try snapshot_testing.build(testing.allocator, test_parts);
+    defer testing.allocator.free(bytes);
+    const header: *Header = @ptrCast(bytes.ptr);
+
+    try testing.expectError(error.InvalidSnapshot, init(bytes[0 .. @sizeOf(Header) - 8]));
+    header.magic +%= 1;
+    try testing.expectError(error.InvalidSnapshot, init(bytes));
+    header.magic -%= 1;
+    header.version += 1;
+    try testing.expectError(error.UnsupportedVersion, init(bytes));
+    header.version -= 1;
+    _ = try init(bytes);
+}
+
+test "Snapshot: init rejects truncated sections" {
+    const bytes = try snapshot_testing.build(testing.allocator, test_parts);
+    defer testing.allocator.free(bytes);
+    const header: *Header = @ptrCast(bytes.ptr);
+
+    // Shorter than the header says.
+    try testing.expectError(error.InvalidSnapshot, init(bytes[0 .. bytes.len - 8]));
+    // A section that runs past the end.
+    header.strings.count += @intCast(bytes.len);
+    try testing.expectError(error.InvalidSnapshot, init(bytes));
+    header.strings.count -= @intCast(bytes.len);
+    // A count far past the end.
+    header.types.count = std.math.maxInt(u32);
+    try testing.expectError(error.InvalidSnapshot, init(bytes));
+    header.types.count = test_types.len;
+    // A misaligned section.
+    header.variables.offset += 4;
+    try testing.expectError(error.InvalidSnapshot, init(bytes));
+    header.variables.offset -= 4;
+    header.strings.offset = std.math.maxInt(u32);
+    try testing.expectError(error.InvalidSnapshot, init(bytes));
+}
+
+test "Snapshot: init rejects strings without a terminator" {
+    var parts = test_parts;
+    parts.strings = "\x00x";
+    try expectInit(error.InvalidSnapshot, parts);
+    parts.strings = "";
+    try expectInit(error.InvalidSnapshot, parts);
+}
+
+test "Snapshot: init rejects ranges past their section" {
+    var parts = test_parts;
+    parts.parameterFirst = 1;
+    try expectInit(error.InvalidSnapshot, parts);
+    parts.parameterFirst = std.math.maxInt(u32);
+    try expectInit(error.InvalidSnapshot, parts);
+
+    parts = test_parts;
+    var types = test_types;
+    types[0].fieldCount = 2;
+    parts.types = &types;
+    try expectInit(error.InvalidSnapshot, parts);
+    types = test_types;
+    types[1].bindingRangeCount = 1;
+    try expectInit(error.InvalidSnapshot, parts);
+    types = test_types;
+    types[1].descriptorSetFirst = 1;
+    types[1].descriptorSetCount = 1;
+    try expectInit(error.InvalidSnapshot, parts);
+
+    parts = test_parts;
+    var descriptorSets = test_descriptorSets;
+    descriptorSets[0].descriptorRangeCount = 1;
+    parts.descriptorSets = &descriptorSets;
+    try expectInit(error.InvalidSnapshot, parts);
+
+    parts = test_parts;
+    var entryPoints = test_entryPoints;
+    entryPoints[0].parameterFirst = std.math.maxInt(u32);
+    parts.entryPoints = &entryPoints;
+    try expectInit(error.InvalidSnapshot, parts);
+}
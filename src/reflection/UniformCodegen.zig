@@ -0,0 +1,274 @@
+//! Generates Zig `extern struct` definitions that mirror the `UNIFORM`
+//! layout of reflected types, padding included, so a CPU-side value can be
+//! uploaded to its constant buffer with one `memcpy`. Every generated struct
+//! asserts its size and field offsets at comptime, so a layout change in the
+//! shader fails the build instead of corrupting uploads.
+//!
+//! ```zig
+//! var out: std.Io.Writer.Allocating = .init(allocator);
+//! var codegen: UniformCodegen = .init(allocator, &out.writer);
+//! defer codegen.deinit();
+//! try codegen.addStruct("Globals", constantBuffer.getType().getElementType());
+//! ```
+//!
+//! Nested structs are emitted once, before their first user, under their
+//! Slang name. Fields without uniform bytes, such as resources, are left
+//! out, since they are bound separately from the block. Array elements and
+//! matrix rows whose stride exceeds their size get an inline padded wrapper
+//! with the value in `value`. D3D constant buffer packing leaves the last
+//! element unpadded and may start the next field inside its stride; such
+//! arrays become `struct { head, last }` with the final element in `last`.
+//! Vectors and matrices map to arrays of the scalar type, and `bool` maps to
+//! `u32`.
+
+const std = @import("std");
+const lib = @import("../lib.zig");
+const TypeLayoutReflection = @import("TypeLayoutReflection.zig");
+
+const Self = @This();
+
+pub const Error = error{
+    OutOfMemory,
+    WriteFailed,
+    /// A field overlaps the previous one or a type has no plain-data mapping
+    /// (interfaces, unsized arrays, anonymous structs).
+    UnsupportedLayout,
+    /// Two different layouts would be emitted under the same struct name,
+    /// e.g. same-named structs from different modules.
+    NameConflict,
+};
+
+const category: lib.ParameterCategory = .UNIFORM;
+
+allocator: std.mem.Allocator,
+writer: *std.Io.Writer,
+// Struct names already written, with the layout each was written for.
+emitted: std.StringHashMapUnmanaged(TypeLayoutReflection) = .empty,
+wrotePrelude: bool = false,
+
+pub fn init(allocator: std.mem.Allocator, writer: *std.Io.Writer) Self {
+    return .{ .allocator = allocator, .writer = writer };
+}
+
+pub fn deinit(self: *Self) void {
+    var names = self.emitted.keyIterator();
+    while (names.next()) |name| self.allocator.free(name.*);
+    self.emitted.deinit(self.allocator);
+    self.* = undefined;
+}
+
+/// Whether `a` and `b` produce the same generated struct. The same Slang
+/// type can come back as distinct layout objects, so pointers alone are not
+/// enough.
+fn sameLayout(a: TypeLayoutReflection, b: TypeLayoutReflection) bool {
+    if (a.ptr == b.ptr) return true;
+    if (a.getSize(category) != b.getSize(category) or a.getFieldCount() != b.getFieldCount()) return false;
+    for (0..a.getFieldCount()) |i| {
+        const fieldA = a.getFieldByIndex(@intCast(i));
+        const fieldB = b.getFieldByIndex(@intCast(i));
+        if (!std.mem.eql(u8, fieldA.getName(), fieldB.getName()) or
+            fieldA.getOffset(category) != fieldB.getOffset(category) or
+            fieldA.getType().getKind() != fieldB.getType().getKind() or
+            fieldA.getType().getSize(category) != fieldB.getType().getSize(category))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Writes `name` as an `extern struct` matching `layout`, preceded by any
+/// struct types its fields use that were not written yet. The struct is
+/// built in memory first, so an `UnsupportedLayout` leaves nothing of it in
+/// the output and a later call may retry the name.
+pub fn addStruct(self: *Self, name: []const u8, layout: TypeLayoutReflection) Error!void {
+    if (self.emitted.get(name)) |previous| {
+        if (sameLayout(previous, layout)) return;
+        return error.NameConflict;
+    }
+    for (0..layout.getFieldCount()) |i| {
+        try self.addNested(layout.getFieldByIndex(@intCast(i)).getType());
+    }
+
+    var body: std.Io.Writer.Allocating = .init(self.allocator);
+    defer body.deinit();
+    const w = &body.writer;
+    try w.print("pub const {f} = extern struct {{\n", .{std.zig.fmtId(name)});
+
+    var cursor: usize = 0;
+    var padCount: usize = 0;
+    for (0..layout.getFieldCount()) |i| {
+        const field = layout.getFieldByIndex(@intCast(i));
+        const fieldType = field.getType();
+        // Resources and other opaque fields take no uniform bytes.
+        if (fieldType.getSize(category) == 0) continue;
+        const offset = field.getOffset(category);
+        if (offset < cursor) return error.UnsupportedLayout;
+        if (offset > cursor) {
+            try w.print("    _pad{d}: [{d}]u8 = @splat(0),\n", .{ padCount, offset - cursor });
+            padCount += 1;
+        }
+        // Bytes up to the next field or the end of the struct.
+        var limit = layout.getSize(category);
+        for (i + 1..layout.getFieldCount()) |j| {
+            const next = layout.getFieldByIndex(@intCast(j));
+            if (next.getType().getSize(category) == 0) continue;
+            limit = next.getOffset(category);
+            break;
+        }
+        try w.print("    {f}: ", .{std.zig.fmtId(field.getName())});
+        cursor = offset + try self.writeType(w, fieldType, limit -| offset);
+        try w.writeAll(",\n");
+    }
+    const size = layout.getSize(category);
+    if (size < cursor) return error.UnsupportedLayout;
+    if (size > cursor) {
+        try w.print("    _pad{d}: [{d}]u8 = @splat(0),\n", .{ padCount, size - cursor });
+    }
+
+    try w.print("\n    comptime {{\n        std.debug.assert(@sizeOf(@This()) == {d});\n", .{size});
+    for (0..layout.getFieldCount()) |i| {
+        const field = layout.getFieldByIndex(@intCast(i));
+        if (field.getType().getSize(category) == 0) continue;
+        try w.print("        std.debug.assert(@offsetOf(@This(), \"{f}\") == {d});\n", .{
+            std.zig.fmtString(field.getName()),
+            field.getOffset(category),
+        });
+    }
+    try w.writeAll(
+        \\    }
+        \\
+        \\    /// Copies the whole block into `dst`, which must hold at least
+        \\    /// `@sizeOf(@This())` bytes.
+        \\    pub fn pack(self: *const @This(), dst: []u8) void {
+        \\        @memcpy(dst[0..@sizeOf(@This())], std.mem.asBytes(self));
+        \\    }
+        \\};
+        \\
+        \\
+    );
+
+    // Only a complete struct is published and its name recorded.
+    try self.emitted.ensureUnusedCapacity(self.allocator, 1);
+    const key = try self.allocator.dupe(u8, name);
+    errdefer self.allocator.free(key);
+    if (!self.wrotePrelude) {
+        try self.writer.writeAll("const std = @import(\"std\");\n\n");
+        self.wrotePrelude = true;
+    }
+    try self.writer.writeAll(body.written());
+    self.emitted.putAssumeCapacity(key, layout);
+}
+
+fn addNested(self: *Self, layout: TypeLayoutReflection) Error!void {
+    switch (layout.getKind()) {
+        .STRUCT => {
+            if (layout.getName().len == 0) return error.UnsupportedLayout;
+            try self.addStruct(layout.getName(), layout);
+        },
+        .ARRAY => try self.addNested(layout.getElementType()),
+        else => {},
+    }
+}
+
+fn scalarName(scalarType: lib.ScalarType) Error![]const u8 {
+    return switch (scalarType) {
+        .BOOL => "u32",
+        .INT8 => "i8",
+        .UINT8 => "u8",
+        .INT16 => "i16",
+        .UINT16 => "u16",
+        .INT32 => "i32",
+        .UINT32 => "u32",
+        .INT64 => "i64",
+        .UINT64 => "u64",
+        .FLOAT16 => "f16",
+        .FLOAT32 => "f32",
+        .FLOAT64 => "f64",
+        else => error.UnsupportedLayout,
+    };
+}
+
+fn scalarSize(scalarType: lib.ScalarType) usize {
+    return switch (scalarType) {
+        .INT8, .UINT8 => 1,
+        .INT16, .UINT16, .FLOAT16 => 2,
+        .INT64, .UINT64, .FLOAT64 => 8,
+        else => 4,
+    };
+}
+
+/// Writes `count` elements spaced `stride` bytes apart, wrapping the element
+/// type in a padded struct when the stride is larger than it. When the fully
+/// padded array does not fit in `available` bytes, the last element is left
+/// unpadded.
+fn writeStrided(w: *std.Io.Writer, count: usize, stride: usize, element: []const u8, elementSize: usize, available: usize) Error!usize {
+    if (stride < elementSize) return error.UnsupportedLayout;
+    if (stride == elementSize) {
+        try w.print("[{d}]{s}", .{ count, element });
+        return count * stride;
+    }
+    if (count * stride <= available) {
+        try w.print("[{d}]extern struct {{ value: {s}, _pad: [{d}]u8 = @splat(0) }}", .{ count, element, stride - elementSize });
+        return count * stride;
+    }
+    if (count == 1) {
+        try w.writeAll(element);
+        return elementSize;
+    }
+    try w.print("extern struct {{ head: [{d}]extern struct {{ value: {s}, _pad: [{d}]u8 = @splat(0) }}, last: {s} }}", .{
+        count - 1,
+        element,
+        stride - elementSize,
+        element,
+    });
+    return (count - 1) * stride + elementSize;
+}
+
+/// Writes the Zig type for `layout`, which may use at most `available`
+/// bytes, and returns its size in bytes.
+fn writeType(self: *Self, w: *std.Io.Writer, layout: TypeLayoutReflection, available: usize) Error!usize {
+    switch (layout.getKind()) {
+        .SCALAR => {
+            const scalarType = layout.getScalarType();
+            try w.writeAll(try scalarName(scalarType));
+            return scalarSize(scalarType);
+        },
+        .VECTOR => {
+            const scalarType = layout.getScalarType();
+            const count = layout.getElementCount(null);
+            try w.print("[{d}]{s}", .{ count, try scalarName(scalarType) });
+            return count * scalarSize(scalarType);
+        },
+        .MATRIX => {
+            const scalarType = layout.getScalarType();
+            const rows = layout.getRowCount();
+            const columns = layout.getColumnCount();
+            // Column-major matrices are stored as one vector per column.
+            const columnMajor = layout.getMatrixMode() == .SLANG_MATRIX_LAYOUT_COLUMN_MAJOR;
+            const vectorCount: usize = if (columnMajor) columns else rows;
+            const vectorLength: usize = if (columnMajor) rows else columns;
+            if (vectorCount == 0) return error.UnsupportedLayout;
+            var vector: [32]u8 = undefined;
+            const vectorType = std.fmt.bufPrint(&vector, "[{d}]{s}", .{ vectorLength, try scalarName(scalarType) }) catch unreachable;
+            const vectorSize = vectorLength * scalarSize(scalarType);
+            const alignment: usize = @intCast(@max(layout.getAlignment(category), 1));
+            return writeStrided(w, vectorCount, std.mem.alignForwardAnyAlign(usize, vectorSize, alignment), vectorType, vectorSize, available);
+        },
+        .ARRAY => {
+            const count = layout.getElementCount(null);
+            if (count == 0) return error.UnsupportedLayout;
+            var element: std.Io.Writer.Allocating = .init(self.allocator);
+            defer element.deinit();
+            const stride = layout.getElementStride(category);
+            const elementSize = try self.writeType(&element.writer, layout.getElementType(), stride);
+            return writeStrided(w, count, stride, element.written(), elementSize, available);
+        },
+        .STRUCT => {
+            if (layout.getName().len == 0) return error.UnsupportedLayout;
+            try w.print("{f}", .{std.zig.fmtId(layout.getName())});
+            return layout.getSize(category);
+        },
+        else => return error.UnsupportedLayout,
+    }
+}
@@ -0,0 +1,53 @@
+//! Hand-built reflection snapshots for unit tests, so code that reads a
+//! `ReflectionSnapshot` can be tested without a Slang session.
+
+const std = @import("std");
+const lib = @import("../lib.zig");
+const Snapshot = @import("Snapshot.zig");
+
+const c = lib.c;
+
+pub const Parts = struct {
+    types: []const Snapshot.Type = &.{},
+    variables: []const Snapshot.Variable = &.{},
+    bindingRanges: []const Snapshot.BindingRange = &.{},
+    descriptorSets: []const Snapshot.DescriptorSet = &.{},
+    descriptorRanges: []const Snapshot.DescriptorRange = &.{},
+    entryPoints: []const Snapshot.EntryPoint = &.{},
+    strings: []const u8 = "\x00",
+    parameterFirst: u32 = 0,
+    parameterCount: u32 = 0,
+    globalParamsType: u32 = Snapshot.none,
+};
+
+const sections = .{ "types", "variables", "bindingRanges", "descriptorSets", "descriptorRanges", "entryPoints", "strings" };
+
+/// Lays `parts` out after a header the way `writeReflectionSnapshot` does,
+/// each section 8-byte aligned. Free with `allocator.free`.
+pub fn build(allocator: std.mem.Allocator, parts: Parts) ![]align(8) u8 {
+    var size = std.mem.alignForward(usize, @sizeOf(Snapshot.Header), 8);
+    inline for (sections) |name| {
+        size = std.mem.alignForward(usize, size + std.mem.sliceAsBytes(@field(parts, name)).len, 8);
+    }
+    const bytes = try allocator.alignedAlloc(u8, .@"8", size);
+    @memset(bytes, 0);
+
+    var header: Snapshot.Header = .{
+        .magic = c.SLANGC_REFLECTION_SNAPSHOT_MAGIC,
+        .version = c.SLANGC_REFLECTION_SNAPSHOT_VERSION,
+        .totalSize = size,
+        .parameterFirst = parts.parameterFirst,
+        .parameterCount = parts.parameterCount,
+        .globalParamsType = parts.globalParamsType,
+        .globalConstantBufferBinding = Snapshot.none,
+    };
+    var offset = std.mem.alignForward(usize, @sizeOf(Snapshot.Header), 8);
+    inline for (sections) |name| {
+        const data = std.mem.sliceAsBytes(@field(parts, name));
+        @memcpy(bytes[offset..][0..data.len], data);
+        @field(header, name) = .{ .offset = @intCast(offset), .count = @intCast(@field(parts, name).len) };
+        offset = std.mem.alignForward(usize, offset + data.len, 8);
+    }
+    @memcpy(bytes[0..@sizeOf(Snapshot.Header)], std.mem.asBytes(&header));
+    return bytes;
+}